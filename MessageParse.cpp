@@ -11,6 +11,7 @@
 #include "boost/algorithm/string.hpp"
 #include"FileUtil.h"
 #include<unordered_set>
+#include<algorithm>
 
 bool MessageParser::LoadXml(const std::string& file_path)
 {
@@ -440,6 +441,183 @@ bool MessageParser::LoadXml(const std::string& file_path)
     return true;
 }
 
+//schema Endian -> mp::DataBuffer::ByteOrder
+static std::string GetByteOrderName(EndianType endian)
+{
+    switch (endian)
+    {
+    case EndianType::big:
+        return "kBigEndian";
+    case EndianType::little:
+        return "kLittleEndian";
+    default:
+        return "kRuntime";
+    }
+}
+
+//连续的定长字段(整数,FIXARRAY)合并成一段: F_RUN_BEGIN 处记录段长 F_RUN_SIZE,
+//每个字段记录段内偏移 F_OFFSET, Decode 对整段只做一次长度检查
+static void MarkFixedRuns(inja::json& fields)
+{
+    size_t run_begin = 0;
+    uint32_t offset = 0;
+    bool in_run = false;
+
+    for (size_t i = 0; i <= fields.size(); ++i)
+    {
+        bool fixed = i < fields.size()
+            && fields[i]["F_FILED_TYPE"].get<int32_t>() == static_cast<int32_t>(FieldType::Primitive)
+            && fields[i]["F_TYPE_INFO"]["T_PRIMITIVE_TYPE"].get<std::string>() != "STRING";
+
+        if (in_run && !fixed)
+        {
+            fields[run_begin]["F_RUN_SIZE"] = offset;
+            fields[i - 1]["F_RUN_END"] = true;
+            in_run = false;
+        }
+
+        if (i == fields.size())
+        {
+            break;
+        }
+
+        fields[i]["F_IN_RUN"] = fixed;
+        fields[i]["F_RUN_BEGIN"] = fixed && !in_run;
+        fields[i]["F_RUN_END"] = false;
+        if (!fixed)
+        {
+            continue;
+        }
+
+        if (!in_run)
+        {
+            in_run = true;
+            run_begin = i;
+            offset = 0;
+        }
+
+        fields[i]["F_OFFSET"] = offset;
+        offset += fields[i]["F_TYPE_INFO"]["T_LENGTH"].get<uint32_t>();
+    }
+}
+
+//字段的 json 描述
+static inja::json FieldToJson(FieldInfoBase& f, std::unordered_map<std::string, TypeInfoBase>& type_info_map)
+{
+    inja::json j_field;
+    j_field["F_DESCRIPTION"] = f.GetDescription();
+    j_field["F_FILED_TYPE"] = f.GetFiledType();
+    j_field["F_NAME"] = f.GetName();
+    j_field["F_PRIMITIVE_TYPE"] = f.GetPrimitiveType();
+    j_field["F_LENGTH"] = f.GetLength();
+    auto it = type_info_map.find(f.GetPrimitiveType());
+    if (it != type_info_map.end())
+    {
+        if (TypeRecognition::IsPrimitiveTypeInt(it->second.GetPrimitiveType()))
+        {
+            j_field["F_TYPE_INFO"] =
+            {
+                {"T_NAME",type_info_map[it->second.GetPrimitiveType()].GetName()},
+                {"T_PRIMITIVE_TYPE",type_info_map[it->second.GetPrimitiveType()].GetPrimitiveType()},
+                {"T_LENGTH",type_info_map[it->second.GetPrimitiveType()].GetLength()}
+            };
+
+        }
+        else//string fixarray
+        {
+            j_field["F_TYPE_INFO"] =
+            {
+                {"T_NAME",it->second.GetName()},
+                {"T_PRIMITIVE_TYPE",it->second.GetPrimitiveType()},
+                {"T_LENGTH",it->second.GetLength()}
+            };
+        }
+    }
+    else//field 中直接 FIXARRAY
+    {
+        j_field["F_TYPE_INFO"] =
+        {
+            {"T_NAME",f.GetPrimitiveType()},
+            {"T_PRIMITIVE_TYPE",f.GetPrimitiveType()},
+            {"T_LENGTH",f.GetLength()}
+        };
+    }
+
+    return j_field;
+}
+
+//线上(wire)布局: 含继承字段, 基类在前. F_WIRE_KIND: FIXED STRING SEQ_FIXED SEQ_STRING SEQ_MESSAGE
+static void CollectWireFields(const std::string& msg_name, std::unordered_map<std::string, MessageInfoBase>& msg_map,
+    std::unordered_map<std::string, TypeInfoBase>& type_info_map, inja::json& fields)
+{
+    auto& msg_info = msg_map[msg_name];
+    if (!msg_info.GetInherit().empty())
+    {
+        CollectWireFields(msg_info.GetInherit(), msg_map, type_info_map, fields);
+    }
+
+    auto msg_fields = msg_info.GetFields();
+    for (auto& f : msg_fields)
+    {
+        inja::json j_field = FieldToJson(f, type_info_map);
+        std::string primitive_type = j_field["F_TYPE_INFO"]["T_PRIMITIVE_TYPE"];
+        bool is_string = (primitive_type == "STRING");
+        bool is_fixed = !is_string && !msg_map.count(primitive_type);
+        if (f.GetFiledType() == FieldType::Primitive)
+        {
+            j_field["F_WIRE_KIND"] = is_string ? "STRING" : "FIXED";
+        }
+        else
+        {
+            j_field["F_WIRE_KIND"] = is_string ? "SEQ_STRING" : (is_fixed ? "SEQ_FIXED" : "SEQ_MESSAGE");
+        }
+        j_field["F_WIRE_SIZE"] = (is_fixed ? j_field["F_TYPE_INFO"]["T_LENGTH"].get<uint32_t>() : 0);
+        j_field["F_INDEX"] = fields.size();
+        fields.push_back(j_field);
+    }
+}
+
+//定长前缀中的字段带 F_FIXED_OFFSET; 前缀之后的字段偏移要在运行时跳读得到
+static void SetWireLayout(const std::string& msg_name, std::unordered_map<std::string, MessageInfoBase>& msg_map,
+    std::unordered_map<std::string, TypeInfoBase>& type_info_map, inja::json& json)
+{
+    inja::json fields = inja::json::array();
+    CollectWireFields(msg_name, msg_map, type_info_map, fields);
+
+    uint32_t prefix_size = 0;
+    size_t prefix_count = 0;
+    for (auto& f : fields)
+    {
+        if (f["F_WIRE_KIND"] != "FIXED")
+        {
+            break;
+        }
+        f["F_FIXED_OFFSET"] = prefix_size;
+        prefix_size += f["F_WIRE_SIZE"].get<uint32_t>();
+        prefix_count++;
+    }
+    for (size_t i = 0; i < fields.size(); ++i)
+    {
+        fields[i]["F_IN_PREFIX"] = (i < prefix_count);
+    }
+
+    json["WIRE_FIELDS"] = fields;
+    json["WIRE_FIELD_COUNT"] = fields.size();
+    json["WIRE_PREFIX_FIELD_COUNT"] = prefix_count;
+    json["WIRE_PREFIX_SIZE"] = prefix_size;
+    //全是定长字段(含基类)的消息整体按打包结构体编解码
+    json["FIXED_LAYOUT"] = !fields.empty() && prefix_count == fields.size();
+
+    //最短编码: STRING/Sequence 都为空时只有 4 字节长度; 有 STRING/Sequence 的消息长度无上限
+    uint32_t min_size = 0;
+    for (auto& f : fields)
+    {
+        min_size += (f["F_WIRE_KIND"] == "FIXED") ? f["F_WIRE_SIZE"].get<uint32_t>() : 4;
+    }
+    json["MIN_WIRE_SIZE"] = min_size;
+    json["WIRE_SIZE_BOUNDED"] = (prefix_count == fields.size());
+}
+
 bool MessageParser::Write(const std::string& template_path, const std::string& write_path)
 {
     try
@@ -494,12 +672,23 @@ bool MessageParser::Write(const std::string& template_path, const std::string& w
             std::cout << fmt::format("parse TEMPLATE_MESSAGE_CPP\n");
             inja::Template temp_msg_cpp = env.parse_template("TEMPLATE_MESSAGE_CPP.txt");
 
+            //没有子类的消息生成为 final
+            std::unordered_set<std::string> base_names;
+            for (auto& [key, value] : msg_name_struct_map_)
+            {
+                if (!value.GetInherit().empty())
+                {
+                    base_names.insert(value.GetInherit());
+                }
+            }
+
             for (auto& [key, value] : msg_name_struct_map_)
             {
                 inja::json json;
                 json["NAMESPACE"] = v_namespace_;
                 json["MSG_DESCRIPTION"] = value.GetDescription();
                 json["MSG_INHERIT"] = value.GetInherit();
+                json["MSG_FINAL"] = (base_names.count(key) == 0);
                 json["MSG_PKT_NO"] = value.GetPktNo();
                 json["MSG_NAME"] = value.GetName();
 
@@ -507,49 +696,16 @@ bool MessageParser::Write(const std::string& template_path, const std::string& w
 
                 for (auto& f : field_info)
                 {
-                    inja::json j_field;
-                    j_field["F_DESCRIPTION"] = f.GetDescription();
-                    j_field["F_FILED_TYPE"] = f.GetFiledType();
-                    j_field["F_NAME"] = f.GetName();
-                    j_field["F_PRIMITIVE_TYPE"] = f.GetPrimitiveType();
-                    j_field["F_LENGTH"] = f.GetLength();
-                    auto it = type_info_map_.find(f.GetPrimitiveType());
-                    if (it != type_info_map_.end())
-                    {
-                        if (TypeRecognition::IsPrimitiveTypeInt(it->second.GetPrimitiveType()))
-                        {
-                            j_field["F_TYPE_INFO"] =
-                            {
-                                {"T_NAME",type_info_map_[it->second.GetPrimitiveType()].GetName()},
-                                {"T_PRIMITIVE_TYPE",type_info_map_[it->second.GetPrimitiveType()].GetPrimitiveType()},
-                                {"T_LENGTH",type_info_map_[it->second.GetPrimitiveType()].GetLength()}
-                            };
-
-                        }
-                        else//string fixarray
-                        {
-                            j_field["F_TYPE_INFO"] =
-                            {
-                                {"T_NAME",it->second.GetName()},
-                                {"T_PRIMITIVE_TYPE",it->second.GetPrimitiveType()},
-                                {"T_LENGTH",it->second.GetLength()}
-                            };
-                        }
-                    }
-                    else//field 中直接 FIXARRAY
-                    {
-                        j_field["F_TYPE_INFO"] =
-                        {
-                            {"T_NAME",f.GetPrimitiveType()},
-                            {"T_PRIMITIVE_TYPE",f.GetPrimitiveType()},
-                            {"T_LENGTH",f.GetLength()}
-                        };
-                    }
-
-
+                    inja::json j_field = FieldToJson(f, type_info_map_);
                     json["FIELDS"].push_back(j_field);
                 }
 
+                if (json.contains("FIELDS"))
+                {
+                    MarkFixedRuns(json["FIELDS"]);
+                }
+                SetWireLayout(key, msg_name_struct_map_, type_info_map_, json);
+
                 std::cout << fmt::format("write {}.h\n", key);
                 env.write(temp_msg_h, json, key + ".h");
                 std::cout << fmt::format("write {}.cpp\n", key);
@@ -566,6 +722,7 @@ bool MessageParser::Write(const std::string& template_path, const std::string& w
 
             inja::json types_json;
             types_json["NAMESPACE"] = v_namespace_;
+            types_json["BYTE_ORDER"] = GetByteOrderName(endian_);
             for (auto& msg_info : v_msg_struct_info_)
             {
                 if (msg_info.GetPktNo() == 0)
@@ -577,6 +734,8 @@ bool MessageParser::Write(const std::string& template_path, const std::string& w
                 json["MSG_INHERIT"] = msg_info.GetInherit();
                 json["MSG_PKT_NO"] = msg_info.GetPktNo();
                 json["MSG_NAME"] = msg_info.GetName();
+                SetWireLayout(msg_info.GetName(), msg_name_struct_map_, type_info_map_, json);
+                json.erase("WIRE_FIELDS");
 
                 types_json["MSG_INFOS"].push_back(json);
             }
@@ -611,6 +770,19 @@ bool MessageParser::Write(const std::string& template_path, const std::string& w
             json["NAMESPACE"] = v_namespace_;
             json["FILENAME"] = file_name_;
 
+            //按消息号排序, 生成有序消息号表和 switch
+            std::vector<int32_t> v_pkt_no;
+            for (auto& msg_info : v_msg_struct_info_)
+            {
+                if (msg_info.GetPktNo() != 0)
+                    v_pkt_no.push_back(msg_info.GetPktNo());
+            }
+            std::sort(v_pkt_no.begin(), v_pkt_no.end());
+            for (auto pkt_no : v_pkt_no)
+            {
+                json["MSG_PKT_NOS"].push_back(pkt_no);
+            }
+
 
             std::string write_file_name = "MessageFactory.h";
             std::cout << fmt::format("write {}\n", write_file_name);
@@ -646,6 +818,34 @@ bool MessageParser::Write(const std::string& template_path, const std::string& w
             std::cout << fmt::format("write {}\n", write_file_name);
             env.write(temp_factory_register_cpp, types_json, write_file_name);
         }
+        //消息分发
+        if (1)
+        {
+            std::cout << fmt::format("parse TEMPLATE_MESSAGE_DISPATCHER_H.txt\n");
+            inja::Template temp_dispatcher_h = env.parse_template("TEMPLATE_MESSAGE_DISPATCHER_H.txt");
+
+            inja::json types_json;
+            types_json["NAMESPACE"] = v_namespace_;
+            types_json["FILENAME"] = file_name_;
+            types_json["MSG_INFOS"] = inja::json::array();
+
+            for (auto& msg_info : v_msg_struct_info_)
+            {
+                if (msg_info.GetPktNo() == 0)
+                    continue;
+
+                inja::json json;
+                json["MSG_DESCRIPTION"] = msg_info.GetDescription();
+                json["MSG_PKT_NO"] = msg_info.GetPktNo();
+                json["MSG_NAME"] = msg_info.GetName();
+
+                types_json["MSG_INFOS"].push_back(json);
+            }
+
+            std::string write_file_name = "MessageDispatcher.h";
+            std::cout << fmt::format("write {}\n", write_file_name);
+            env.write(temp_dispatcher_h, types_json, write_file_name);
+        }
 
 
         //类型定义
@@ -1,6 +1,8 @@
 #pragma once
 #include <functional>
+#include <memory>
 #include <unordered_map>
+#include "ObjectPool.h"
 namespace mp
 {
     template <typename KEY_TYPE, typename BASE_CLASS_TYPE, typename... U>
@@ -12,6 +14,10 @@ namespace mp
             register_t(const KEY_TYPE& key)
             {
                 factory<KEY_TYPE, BASE_CLASS_TYPE, U...>::get().map_.emplace(key, [](U&&... u) { return new T(std::forward<U>(u)...); });
+                if constexpr (sizeof...(U) == 0)
+                {
+                    factory<KEY_TYPE, BASE_CLASS_TYPE, U...>::get().pool_map_.emplace(key, &acquire_pooled<T>);
+                }
             }
 
             register_t(const KEY_TYPE& key, std::function<BASE_CLASS_TYPE* (U&&...)>&& f)
@@ -20,6 +26,42 @@ namespace mp
             }
         };
 
+        // returns released objects to ObjectPool<T> instead of deleting them
+        struct pool_deleter
+        {
+            void (*release)(BASE_CLASS_TYPE*) = nullptr;
+
+            void operator()(BASE_CLASS_TYPE* p) const noexcept
+            {
+                release(p);
+            }
+        };
+
+        using pooled_ptr = std::unique_ptr<BASE_CLASS_TYPE, pool_deleter>;
+
+        // acquire_pooled reuses a Clear()ed T from its lock-free pool, or allocates one when the
+        // pool is empty; the object goes back to the pool when the pointer is destroyed, on
+        // whichever thread that happens. The caller picks T (the generated message table
+        // switches on the message number), so no lookup is involved.
+        template<typename T>
+        static pooled_ptr acquire_pooled()
+        {
+            return pooled_ptr(ObjectPool<T>::Instance().Acquire(), pool_deleter{ &release_pooled<T> });
+        }
+
+        // acquire is acquire_pooled<T>() for the T registered under key with register_t<T>(key),
+        // an empty pointer for an unknown key or a type registered with its own creation function.
+        // Only for factories without constructor arguments.
+        inline pooled_ptr acquire(const KEY_TYPE& key)
+        {
+            auto it = pool_map_.find(key);
+            if (it != pool_map_.end())
+            {
+                return it->second();
+            }
+            return pooled_ptr();
+        }
+
         inline BASE_CLASS_TYPE* create(const KEY_TYPE& key, U&&... u)
         {
             auto it = map_.find(key);
@@ -40,6 +82,13 @@ namespace mp
         factory<KEY_TYPE, BASE_CLASS_TYPE, U...>() {};
         factory<KEY_TYPE, BASE_CLASS_TYPE, U...>(const factory<KEY_TYPE, BASE_CLASS_TYPE, U...>&) = delete;
         factory<KEY_TYPE, BASE_CLASS_TYPE, U...>(factory<KEY_TYPE, BASE_CLASS_TYPE, U...>&&) = delete;
+        template<typename T>
+        static void release_pooled(BASE_CLASS_TYPE* p) noexcept
+        {
+            ObjectPool<T>::Instance().Release(static_cast<T*>(p));
+        }
+
         std::unordered_map<KEY_TYPE, std::function<BASE_CLASS_TYPE* (U&&...)>> map_;
+        std::unordered_map<KEY_TYPE, pooled_ptr(*)()> pool_map_;
     };
 }
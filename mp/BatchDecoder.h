@@ -0,0 +1,186 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <deque>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+#include "MpTypes.h"
+#include "DataBuffer.hpp"
+#include "DataBufferView.hpp"
+#include "FrameHeader.h"
+#include "MessageBase.h"
+#include "MessageDecoder.h"
+
+#if defined(_MSC_VER) && !defined(__clang__) && (defined(_M_X64) || defined(_M_IX86))
+#include <xmmintrin.h>
+#endif
+
+namespace mp
+{
+    namespace detail
+    {
+        inline void Prefetch(const void* p) noexcept
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(p);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+            _mm_prefetch(static_cast<const char*>(p), _MM_HINT_T0);
+#else
+            (void)p;
+#endif
+        }
+    }
+
+    // BatchDecoder decodes the complete frames (FrameHeader + body) at the front of a read in one
+    // call, each into a message of the type its header names, so a read mixing any of Messages
+    // decodes in one pass whatever their order. Every type has its own instances, reused from
+    // batch to batch, and the calls are qualified, so no heap object and no virtual call per frame;
+    // the bytes of frame i + 1 are prefetched while frame i decodes.
+    // Frame(i) is frame i of the last batch with its message and Decode result: a frame of a type
+    // that is not one of Messages, or whose body does not decode to exactly body_length bytes, gets
+    // kReadError (and no message for an unknown type) and the frames after it still decode.
+    // Messages of a batch stay valid until the next Decode, so use one decoder per thread.
+    // byte_order is the schema's kByteOrder, as for MessageFramer; generated code has
+    // <File>BatchDecoder over all the schema's messages.
+    template <DataBuffer::ByteOrder byte_order, typename... Messages>
+    class BatchDecoder
+    {
+    public:
+        struct DecodedFrame
+        {
+            FrameHeader header;
+            MessageBase* message; // nullptr if header.message_type is not one of Messages
+            ErrorCode error;
+        };
+
+        static const size_t kDefaultMaxCount = 1024;
+
+        // max_count bounds the frames taken by one Decode
+        explicit BatchDecoder(size_t max_count = kDefaultMaxCount, bool host_to_network_byte_order = true)
+            : msg_types_{ { Messages().Messages::GetMsgType()... } }
+            , max_count_(max_count)
+            , host_to_network_byte_order_(host_to_network_byte_order)
+        {
+            frames_.reserve(max_count);
+        }
+
+        BatchDecoder(const BatchDecoder&) = delete;
+
+        BatchDecoder& operator=(const BatchDecoder&) = delete;
+
+        // decodes the complete frames at the front of [data, data + size), at most max_count of
+        // them; consumed is set to their total size and a trailing partial frame is left alone.
+        // Returns the number of frames taken.
+        size_t Decode(const char* data, size_t size, size_t& consumed)
+        {
+            frames_.clear();
+            used_.fill(0);
+            consumed = 0;
+            while (frames_.size() < max_count_ && size - consumed >= FrameHeader::kSize)
+            {
+                const char* frame = data + consumed;
+                FrameHeader header = FrameHeader::Load<byte_order>(frame, host_to_network_byte_order_);
+                if (size - consumed < header.FrameSize())
+                {
+                    break;
+                }
+
+                // the next frame starts right after this one: fetch it while this one decodes
+                if (size - consumed > header.FrameSize())
+                {
+                    detail::Prefetch(frame + header.FrameSize());
+                }
+
+                DecodedFrame decoded{ header, nullptr, ErrorCode::kReadError };
+                DecodeAs<0>(frame + FrameHeader::kSize, decoded);
+                frames_.push_back(decoded);
+                consumed += header.FrameSize();
+            }
+
+            return frames_.size();
+        }
+
+        // same over the readable bytes of buffer, consuming the frames taken
+        size_t Decode(DataBuffer& buffer)
+        {
+            size_t consumed = 0;
+            size_t count = Decode(buffer.Data(), buffer.Size(), consumed);
+            buffer.Consume(consumed);
+            return count;
+        }
+
+        // frames of the last batch
+        size_t Count() const noexcept
+        {
+            return frames_.size();
+        }
+
+        const DecodedFrame& Frame(size_t i) const noexcept
+        {
+            return frames_[i];
+        }
+
+        // message of frame i as a T, nullptr if frame i is not a T
+        template <typename T>
+        T* Get(size_t i) const noexcept
+        {
+            static_assert(IndexOf<T>() < sizeof...(Messages), "T is not one of Messages");
+            return frames_[i].header.message_type == msg_types_[IndexOf<T>()] ? static_cast<T*>(frames_[i].message)
+                : nullptr;
+        }
+
+    private:
+        template <typename T>
+        static constexpr size_t IndexOf() noexcept
+        {
+            constexpr bool same[] = { std::is_same<T, Messages>::value..., false };
+            size_t i = 0;
+            while (!same[i])
+            {
+                ++i;
+            }
+            return i;
+        }
+
+        // compares the header with each type in turn, decodes into the next free instance of the
+        // matching one; the body must be consumed exactly
+        template <size_t I>
+        void DecodeAs(const char* body, DecodedFrame& frame)
+        {
+            if constexpr (I < sizeof...(Messages))
+            {
+                if (frame.header.message_type != msg_types_[I])
+                {
+                    DecodeAs<I + 1>(body, frame);
+                    return;
+                }
+
+                using Message = typename std::tuple_element<I, std::tuple<Messages...>>::type;
+                std::deque<Message>& instances = std::get<I>(messages_);
+                if (used_[I] == instances.size())
+                {
+                    instances.emplace_back();
+                }
+                Message& message = instances[used_[I]++];
+
+                DataBufferView view(body, frame.header.body_length);
+                MessageViewDecoder decoder(view, host_to_network_byte_order_);
+                frame.message = &message;
+                frame.error = message.Message::Decode(decoder);
+                if (frame.error == ErrorCode::kSuccess && view.Size() != 0)
+                {
+                    frame.error = ErrorCode::kReadError;
+                }
+            }
+        }
+
+        std::array<MsgType_Def, sizeof...(Messages)> msg_types_;
+        std::array<size_t, sizeof...(Messages)> used_{};
+        std::tuple<std::deque<Messages>...> messages_; // deque: growing it keeps earlier messages in place
+        std::vector<DecodedFrame> frames_;
+        size_t max_count_;
+        bool host_to_network_byte_order_;
+    };
+
+} // namespace mp
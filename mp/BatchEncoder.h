@@ -0,0 +1,193 @@
+#pragma once
+#include <chrono>
+#include <cstdint>
+#include <vector>
+#include "MpTypes.h"
+#include "DataBuffer.hpp"
+#include "FrameHeader.h"
+#include "MessageBase.h"
+#include "MessageEncoder.h"
+
+namespace mp
+{
+    // FlushPolicy bounds how much a BatchEncoder holds back: the batch should be sent as soon as
+    // any limit is reached, max_delay counting from the first message of the batch.
+    struct FlushPolicy
+    {
+        size_t max_bytes = 64 * 1024;
+        size_t max_messages = 1024;
+        std::chrono::microseconds max_delay = std::chrono::microseconds(100);
+    };
+
+    // BatchEncoder appends many messages as frames (see EncodeFrame) into one contiguous buffer,
+    // so that a single send/writev covers the whole batch. Append(messages, count) sums their
+    // GetMsgSize() and reserves the space once. FrameOffsets() gives where each frame starts,
+    // counted from the start of the batch, bytes already written by FlushToFd included; frames
+    // FlushToFd has written out completely are dropped from it, from MessageCount() and from the
+    // max_messages count, so the first frame left may be partly written. The encoder never
+    // sends by itself: the caller checks ShouldFlush() after appending and arms a timer for
+    // Deadline() so a quiet period still flushes.
+    // byte_order is the schema's kByteOrder, as for EncodeFrame; generated code has <File>BatchEncoder.
+    template <DataBuffer::ByteOrder byte_order>
+    class BatchEncoder
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        explicit BatchEncoder(const FlushPolicy& policy = FlushPolicy(), bool host_to_network_byte_order = true,
+            BufferAllocator* allocator = DefaultBufferAllocator())
+            : buffer_(policy.max_bytes, DataBuffer::kCheapPrependSize, allocator)
+            , policy_(policy)
+            , host_to_network_byte_order_(host_to_network_byte_order)
+        {
+            frame_offsets_.reserve(policy.max_messages);
+        }
+
+        BatchEncoder(const BatchEncoder&) = delete;
+
+        BatchEncoder& operator=(const BatchEncoder&) = delete;
+
+        ErrorCode Append(MessageBase& message)
+        {
+            return AppendFrame(message, message.GetMsgSize());
+        }
+
+        // stops at the first message that fails to encode; the frames before it stay in the batch
+        ErrorCode Append(MessageBase* const* messages, size_t count)
+        {
+            msg_sizes_.resize(count);
+            size_t total = 0;
+            for (size_t i = 0; i < count; ++i)
+            {
+                msg_sizes_[i] = messages[i]->GetMsgSize();
+                total += FrameHeader::kSize + msg_sizes_[i];
+            }
+            buffer_.Prepare(total);
+
+            for (size_t i = 0; i < count; ++i)
+            {
+                ErrorCode ec = AppendFrame(*messages[i], msg_sizes_[i]);
+                if (ec != ErrorCode::kSuccess)
+                {
+                    return ec;
+                }
+            }
+
+            return ErrorCode::kSuccess;
+        }
+
+        bool ShouldFlush(Clock::time_point now = Clock::now()) const noexcept
+        {
+            if (frame_offsets_.empty())
+            {
+                return false;
+            }
+
+            return buffer_.Size() >= policy_.max_bytes || frame_offsets_.size() >= policy_.max_messages
+                || now - first_append_time_ >= policy_.max_delay;
+        }
+
+        // latest time the batch should be flushed, time_point::max() while it is empty
+        Clock::time_point Deadline() const noexcept
+        {
+            if (frame_offsets_.empty())
+            {
+                return Clock::time_point::max();
+            }
+
+            return first_append_time_ + policy_.max_delay;
+        }
+
+        // unsent bytes of the batch
+        const char* Data() const noexcept
+        {
+            return buffer_.Data();
+        }
+
+        size_t Size() const noexcept
+        {
+            return buffer_.Size();
+        }
+
+        size_t MessageCount() const noexcept
+        {
+            return frame_offsets_.size();
+        }
+
+        const std::vector<size_t>& FrameOffsets() const noexcept
+        {
+            return frame_offsets_;
+        }
+
+        DataBuffer& Buffer() noexcept
+        {
+            return buffer_;
+        }
+
+        // starts a new batch, keeping the buffer's capacity; call after the batch has been sent
+        void Clear() noexcept
+        {
+            buffer_.Reset();
+            frame_offsets_.clear();
+            flushed_size_ = 0;
+        }
+
+#if !defined(_WIN32)
+        // writes the batch to fd like DataBuffer::WriteToFd and starts a new batch once everything
+        // is written; after a partial write the rest stays queued in front of later appends and
+        // the frames written out completely are dropped
+        ssize_t FlushToFd(int fd, int* saved_errno = nullptr)
+        {
+            ssize_t n = buffer_.WriteToFd(fd, saved_errno);
+            if (n > 0)
+            {
+                flushed_size_ += static_cast<size_t>(n);
+            }
+
+            if (buffer_.Size() == 0)
+            {
+                Clear();
+            }
+            else
+            {
+                // frame i is written out once frame i + 1 starts within the written bytes
+                size_t sent = 0;
+                while (sent + 1 < frame_offsets_.size() && frame_offsets_[sent + 1] <= flushed_size_)
+                {
+                    ++sent;
+                }
+                frame_offsets_.erase(frame_offsets_.begin(), frame_offsets_.begin() + sent);
+            }
+
+            return n;
+        }
+#endif
+
+    private:
+        ErrorCode AppendFrame(MessageBase& message, uint32_t msg_size)
+        {
+            if (frame_offsets_.empty())
+            {
+                first_append_time_ = Clock::now();
+            }
+
+            size_t offset = flushed_size_ + buffer_.Size();
+            ErrorCode ec = EncodeFrame<byte_order>(message, buffer_, msg_size, host_to_network_byte_order_);
+            if (ec == ErrorCode::kSuccess)
+            {
+                frame_offsets_.push_back(offset);
+            }
+
+            return ec;
+        }
+
+        DataBuffer buffer_;
+        FlushPolicy policy_;
+        bool host_to_network_byte_order_;
+        std::vector<size_t> frame_offsets_;
+        std::vector<uint32_t> msg_sizes_;
+        size_t flushed_size_ = 0;
+        Clock::time_point first_append_time_;
+    };
+
+} // namespace mp
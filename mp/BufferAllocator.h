@@ -0,0 +1,268 @@
+#pragma once
+#include <assert.h>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <new>
+#include <vector>
+
+namespace mp
+{
+    // BufferAllocator is the storage resource used by DataBuffer and SegmentedDataBuffer.
+    class BufferAllocator
+    {
+    public:
+        virtual ~BufferAllocator() {}
+
+        // Allocate returns at least size bytes and updates size to the usable capacity.
+        virtual char* Allocate(size_t& size) = 0;
+
+        // Deallocate takes the capacity reported by Allocate.
+        virtual void Deallocate(char* p, size_t size) noexcept = 0;
+    };
+
+    class NewDeleteAllocator : public BufferAllocator
+    {
+    public:
+        static NewDeleteAllocator& Instance() noexcept
+        {
+            static NewDeleteAllocator instance;
+            return instance;
+        }
+
+        virtual char* Allocate(size_t& size) override
+        {
+            return new char[size];
+        }
+
+        virtual void Deallocate(char* p, size_t /*size*/) noexcept override
+        {
+            delete[] p;
+        }
+    };
+
+    inline BufferAllocator* DefaultBufferAllocator() noexcept
+    {
+        return &NewDeleteAllocator::Instance();
+    }
+
+    struct BufferPoolStats
+    {
+        uint64_t hits = 0;     // Allocate served from a free list
+        uint64_t misses = 0;   // Allocate fell through to the heap
+        uint64_t releases = 0; // Deallocate kept the block for reuse
+        uint64_t discards = 0; // Deallocate returned the block to the heap
+
+        double HitRate() const noexcept
+        {
+            uint64_t total = hits + misses;
+            return total == 0 ? 0.0 : static_cast<double>(hits) / static_cast<double>(total);
+        }
+    };
+
+    // BufferPool rounds requests up to power-of-two size classes and keeps released blocks
+    // in per-thread free lists, so a steady-state workload stops calling the heap.
+    // Blocks released on another thread go to that thread's lists.
+    class BufferPool : public BufferAllocator
+    {
+    public:
+        static const size_t kMinSizeClassShift = 6;  // 64 bytes
+        static const size_t kMaxSizeClassShift = 20; // 1 MiB
+        static const size_t kSizeClassCount = kMaxSizeClassShift - kMinSizeClassShift + 1;
+        static const size_t kMaxCachedBlocks = 64;   // per size class and thread
+
+        static BufferPool& Instance() noexcept
+        {
+            static BufferPool instance;
+            return instance;
+        }
+
+        virtual char* Allocate(size_t& size) override
+        {
+            size_t index = SizeClassIndex(size);
+            if (index >= kSizeClassCount)
+            {
+                return new char[size];
+            }
+
+            size = SizeClassSize(index);
+
+            ThreadCache* cache = LocalCache();
+            if (cache == nullptr)
+            {
+                return new char[size];
+            }
+
+            FreeBlock* block = cache->free_lists[index];
+            if (block != nullptr)
+            {
+                cache->free_lists[index] = block->next;
+                cache->free_counts[index]--;
+                cache->hits.fetch_add(1, std::memory_order_relaxed);
+                return reinterpret_cast<char*>(block);
+            }
+
+            cache->misses.fetch_add(1, std::memory_order_relaxed);
+            return new char[size];
+        }
+
+        virtual void Deallocate(char* p, size_t size) noexcept override
+        {
+            if (p == nullptr)
+            {
+                return;
+            }
+
+            size_t index = SizeClassIndex(size);
+            ThreadCache* cache = index < kSizeClassCount ? LocalCache() : nullptr;
+            if (cache == nullptr || cache->free_counts[index] >= kMaxCachedBlocks)
+            {
+                if (cache != nullptr)
+                {
+                    cache->discards.fetch_add(1, std::memory_order_relaxed);
+                }
+                delete[] p;
+                return;
+            }
+
+            assert(size == SizeClassSize(index));
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(p);
+            block->next = cache->free_lists[index];
+            cache->free_lists[index] = block;
+            cache->free_counts[index]++;
+            cache->releases.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Counters of all threads, including threads that have exited.
+        BufferPoolStats GetStats() const
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            BufferPoolStats stats = retired_stats_;
+            for (auto cache : caches_)
+            {
+                cache->AddTo(stats);
+            }
+            return stats;
+        }
+
+        // Counters of the calling thread only.
+        BufferPoolStats GetThreadStats() const
+        {
+            BufferPoolStats stats;
+            if (ThreadCache* cache = LocalCache())
+            {
+                cache->AddTo(stats);
+            }
+            return stats;
+        }
+
+    private:
+        BufferPool() {}
+        BufferPool(const BufferPool&) = delete;
+        BufferPool& operator=(const BufferPool&) = delete;
+
+        struct FreeBlock
+        {
+            FreeBlock* next;
+        };
+
+        struct ThreadCache
+        {
+            FreeBlock* free_lists[kSizeClassCount] = {};
+            size_t free_counts[kSizeClassCount] = {};
+            // only written by the owning thread; atomic so GetStats() can read them
+            std::atomic<uint64_t> hits{ 0 };
+            std::atomic<uint64_t> misses{ 0 };
+            std::atomic<uint64_t> releases{ 0 };
+            std::atomic<uint64_t> discards{ 0 };
+
+            ThreadCache()
+            {
+                BufferPool::Instance().Register(this);
+            }
+
+            ~ThreadCache()
+            {
+                for (auto& head : free_lists)
+                {
+                    while (head != nullptr)
+                    {
+                        FreeBlock* next = head->next;
+                        delete[] reinterpret_cast<char*>(head);
+                        head = next;
+                    }
+                }
+                BufferPool::Instance().Unregister(this);
+                ThreadCacheAlive() = false;
+            }
+
+            void AddTo(BufferPoolStats& stats) const noexcept
+            {
+                stats.hits += hits.load(std::memory_order_relaxed);
+                stats.misses += misses.load(std::memory_order_relaxed);
+                stats.releases += releases.load(std::memory_order_relaxed);
+                stats.discards += discards.load(std::memory_order_relaxed);
+            }
+        };
+
+        static size_t SizeClassIndex(size_t size) noexcept
+        {
+            size_t shift = kMinSizeClassShift;
+            while (shift <= kMaxSizeClassShift && (size_t(1) << shift) < size)
+            {
+                ++shift;
+            }
+            return shift - kMinSizeClassShift;
+        }
+
+        static size_t SizeClassSize(size_t index) noexcept
+        {
+            return size_t(1) << (index + kMinSizeClassShift);
+        }
+
+        // false once the calling thread's cache has been destroyed
+        static bool& ThreadCacheAlive() noexcept
+        {
+            thread_local bool alive = true;
+            return alive;
+        }
+
+        static ThreadCache* LocalCache() noexcept
+        {
+            if (!ThreadCacheAlive())
+            {
+                return nullptr;
+            }
+
+            thread_local ThreadCache cache;
+            return &cache;
+        }
+
+        void Register(ThreadCache* cache)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            caches_.push_back(cache);
+        }
+
+        void Unregister(ThreadCache* cache)
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            cache->AddTo(retired_stats_);
+            for (auto it = caches_.begin(); it != caches_.end(); ++it)
+            {
+                if (*it == cache)
+                {
+                    caches_.erase(it);
+                    break;
+                }
+            }
+        }
+
+    private:
+        mutable std::mutex mutex_;
+        std::vector<ThreadCache*> caches_;
+        BufferPoolStats retired_stats_;
+    };
+
+} // namespace mp
@@ -0,0 +1,145 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include "EndianConversion.hpp"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define MP_BULK_BYTESWAP_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+#if defined(MP_BULK_BYTESWAP_X86) && (defined(__GNUC__) || defined(__clang__))
+#define MP_TARGET_SSSE3 __attribute__((target("ssse3")))
+#define MP_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define MP_TARGET_SSSE3
+#define MP_TARGET_AVX2
+#endif
+
+namespace mp
+{
+    // ByteSwapInPlace reverses the bytes of every element of an integer array, for decoding
+    // and encoding integer Sequence fields in bulk. On x86 it uses AVX2 or SSSE3 shuffles,
+    // picked once at startup from cpuid, and falls back to endian::swap elsewhere.
+    enum class SimdLevel : uint8_t
+    {
+        kScalar = 0,
+        kSsse3 = 1,
+        kAvx2 = 2
+    };
+
+    namespace detail
+    {
+        inline SimdLevel DetectSimdLevel() noexcept
+        {
+#if defined(MP_BULK_BYTESWAP_X86) && defined(_MSC_VER)
+            int regs[4] = {};
+            __cpuid(regs, 0);
+            int max_leaf = regs[0];
+
+            __cpuid(regs, 1);
+            bool ssse3 = (regs[2] & (1 << 9)) != 0;
+            bool os_ymm = (regs[2] & (1 << 27)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+            bool avx2 = false;
+            if (max_leaf >= 7)
+            {
+                __cpuidex(regs, 7, 0);
+                avx2 = os_ymm && (regs[1] & (1 << 5)) != 0;
+            }
+
+            return avx2 ? SimdLevel::kAvx2 : (ssse3 ? SimdLevel::kSsse3 : SimdLevel::kScalar);
+#elif defined(MP_BULK_BYTESWAP_X86)
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return SimdLevel::kAvx2;
+            }
+            if (__builtin_cpu_supports("ssse3"))
+            {
+                return SimdLevel::kSsse3;
+            }
+            return SimdLevel::kScalar;
+#else
+            return SimdLevel::kScalar;
+#endif
+        }
+
+        inline const SimdLevel kSimdLevel = DetectSimdLevel();
+
+#if defined(MP_BULK_BYTESWAP_X86)
+        // pshufb control reversing each width-byte element of a 32-byte block
+        template <size_t width>
+        struct ByteSwapMask
+        {
+            alignas(32) char bytes[32];
+
+            constexpr ByteSwapMask() : bytes()
+            {
+                for (size_t i = 0; i < 32; ++i)
+                {
+                    bytes[i] = static_cast<char>((i % 16) / width * width + (width - 1 - i % width));
+                }
+            }
+        };
+
+        template <size_t width>
+        inline constexpr ByteSwapMask<width> kByteSwapMask{};
+
+        template <size_t width>
+        MP_TARGET_SSSE3 inline size_t ByteSwapSsse3(char* p, size_t bytes) noexcept
+        {
+            const __m128i mask = _mm_load_si128(reinterpret_cast<const __m128i*>(kByteSwapMask<width>.bytes));
+            size_t i = 0;
+            for (; i + 16 <= bytes; i += 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p + i));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(p + i), _mm_shuffle_epi8(v, mask));
+            }
+            return i;
+        }
+
+        template <size_t width>
+        MP_TARGET_AVX2 inline size_t ByteSwapAvx2(char* p, size_t bytes) noexcept
+        {
+            const __m256i mask = _mm256_load_si256(reinterpret_cast<const __m256i*>(kByteSwapMask<width>.bytes));
+            size_t i = 0;
+            for (; i + 32 <= bytes; i += 32)
+            {
+                __m256i v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p + i));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(p + i), _mm256_shuffle_epi8(v, mask));
+            }
+            return i;
+        }
+#endif
+    } // namespace detail
+
+    template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    inline void ByteSwapInPlace(T* data, size_t count) noexcept
+    {
+        if constexpr (sizeof(T) > 1)
+        {
+            size_t done = 0;
+#if defined(MP_BULK_BYTESWAP_X86)
+            char* p = reinterpret_cast<char*>(data);
+            if (detail::kSimdLevel == SimdLevel::kAvx2)
+            {
+                done = detail::ByteSwapAvx2<sizeof(T)>(p, count * sizeof(T)) / sizeof(T);
+            }
+            else if (detail::kSimdLevel == SimdLevel::kSsse3)
+            {
+                done = detail::ByteSwapSsse3<sizeof(T)>(p, count * sizeof(T)) / sizeof(T);
+            }
+#endif
+            for (size_t i = done; i < count; ++i)
+            {
+                data[i] = endian::swap(data[i]);
+            }
+        }
+    }
+
+} // namespace mp
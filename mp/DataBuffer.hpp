@@ -3,15 +3,26 @@
 #include <cstdint>
 #include <string.h>
 // #include <stdexcept>
+#include "BufferAllocator.h"
 #include "EndianConversion.hpp"
 #include <algorithm>
+#include <array>
 #include <optional>
 #include <string>
 #include <string_view>
 #include <type_traits>
 
+#if !defined(_WIN32)
+#include <errno.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
 namespace mp
 {
+    template <size_t N>
+    class InlineDataBuffer;
+
     class DataBuffer
     {
     public:
@@ -26,15 +37,17 @@ namespace mp
         static const size_t kCheapPrependSize = 8;
         static const size_t kInitialSize = 256;
 
-        explicit DataBuffer(size_t initial_size = kInitialSize, size_t reserved_prepend_size = kCheapPrependSize)
+        explicit DataBuffer(size_t initial_size = kInitialSize, size_t reserved_prepend_size = kCheapPrependSize,
+            BufferAllocator* allocator = DefaultBufferAllocator())
             : capacity_(reserved_prepend_size + initial_size)
             , read_index_(reserved_prepend_size)
             , write_index_(reserved_prepend_size)
             , reserved_prepend_size_(reserved_prepend_size)
+            , allocator_(allocator)
         {
-            buffer_ = new char[capacity_];
+            buffer_ = allocator_->Allocate(capacity_);
             assert(Size() == 0);
-            assert(WritableBytes() == initial_size);
+            assert(WritableBytes() >= initial_size);
             assert(PrependableBytes() == reserved_prepend_size);
         }
 
@@ -42,22 +55,51 @@ namespace mp
 
         DataBuffer& operator=(const DataBuffer&) = delete;
 
-        DataBuffer(DataBuffer&& other) noexcept
+        // the bytes of a buffer using inline storage (see InlineDataBuffer) are copied to the heap,
+        // which may throw, so moves are not noexcept
+        DataBuffer(DataBuffer&& other)
             : buffer_(other.buffer_)
             , capacity_(other.capacity_)
             , read_index_(other.read_index_)
             , write_index_(other.write_index_)
             , reserved_prepend_size_(other.reserved_prepend_size_)
             , endian_(other.endian_)
+            , allocator_(other.allocator_)
         {
+            if (!other.owns_buffer_)
+            {
+                capacity_ = reserved_prepend_size_ + other.Size();
+                buffer_ = allocator_->Allocate(capacity_);
+                memcpy(buffer_ + reserved_prepend_size_, other.Data(), other.Size());
+                read_index_ = reserved_prepend_size_;
+                write_index_ = read_index_ + other.Size();
+                other.Reset();
+                return;
+            }
+
             other.buffer_ = nullptr;
             other.capacity_ = 0;
             other.read_index_ = other.write_index_ = other.reserved_prepend_size_;
             other.endian_ = ByteOrder::kNative;
         }
 
-        DataBuffer& operator=(DataBuffer&& other) noexcept
+        DataBuffer& operator=(DataBuffer&& other)
         {
+            if (this == &other)
+            {
+                return *this;
+            }
+
+            if (!other.owns_buffer_)
+            {
+                Reset();
+                endian_ = other.endian_;
+                Write(other.Data(), other.Size());
+                other.Reset();
+                return *this;
+            }
+
+            ReleaseBuffer();
 
             buffer_ = other.buffer_;
             capacity_ = other.capacity_;
@@ -65,6 +107,8 @@ namespace mp
             write_index_ = other.write_index_;
             reserved_prepend_size_ = other.reserved_prepend_size_;
             endian_ = other.endian_;
+            allocator_ = other.allocator_;
+            owns_buffer_ = true;
 
             other.buffer_ = nullptr;
             other.capacity_ = 0;
@@ -74,21 +118,44 @@ namespace mp
             return *this;
         }
 
+        // moving an InlineDataBuffer into a plain DataBuffer would slice it and copy its bytes
+        template <size_t N>
+        DataBuffer(InlineDataBuffer<N>&&) = delete;
+
+        template <size_t N>
+        DataBuffer& operator=(InlineDataBuffer<N>&&) = delete;
+
         ~DataBuffer()
         {
-            delete[] buffer_;
+            ReleaseBuffer();
             buffer_ = nullptr;
             capacity_ = 0;
         }
 
-        void Swap(DataBuffer& rhs) noexcept
+        void Swap(DataBuffer& rhs)
         {
+            if (!owns_buffer_ || !rhs.owns_buffer_)
+            {
+                // inline storage can't change owner, swap the contents through moves
+                DataBuffer tmp(std::move(*this));
+                *this = std::move(rhs);
+                rhs = std::move(tmp);
+                return;
+            }
+
             std::swap(buffer_, rhs.buffer_);
             std::swap(capacity_, rhs.capacity_);
             std::swap(read_index_, rhs.read_index_);
             std::swap(write_index_, rhs.write_index_);
             std::swap(reserved_prepend_size_, rhs.reserved_prepend_size_);
             std::swap(endian_, rhs.endian_);
+            std::swap(allocator_, rhs.allocator_);
+        }
+
+        // true while the bytes live in storage the buffer does not own (InlineDataBuffer)
+        bool IsInline() const noexcept
+        {
+            return !owns_buffer_;
         }
 
         // read ptr
@@ -136,6 +203,11 @@ namespace mp
             return capacity_;
         }
 
+        BufferAllocator* GetAllocator() const noexcept
+        {
+            return allocator_;
+        }
+
         // Reset resets the buffer to be empty,
         // but it retains the underlying storage for use by future writes.
         // Reset is the same as Truncate(0).
@@ -172,7 +244,7 @@ namespace mp
 
         void Shrink(size_t reserve = 0)
         {
-            DataBuffer other(Size() + reserve);
+            DataBuffer other(Size() + reserve, reserved_prepend_size_, allocator_);
             other.SetEndian(endian_);
             other.Write(Data(), Size());
             Swap(other);
@@ -246,6 +318,11 @@ namespace mp
             endian_ = byte_order;
         }
 
+        ByteOrder GetEndian() const noexcept
+        {
+            return endian_;
+        }
+
     public:
         // Write
         void Write(const void* buf, size_t len)
@@ -309,7 +386,7 @@ namespace mp
             }
             else
             {
-                static_assert(0, "endian error");
+                static_assert(sizeof(T) == 0, "endian error");
             }
         }
 
@@ -442,7 +519,7 @@ namespace mp
             }
             else
             {
-                static_assert(0, "endian error");
+                static_assert(sizeof(T) == 0, "endian error");
             }
             return false;
         }
@@ -596,7 +673,7 @@ namespace mp
             }
             else
             {
-                static_assert(0, "endian error");
+                static_assert(sizeof(T) == 0, "endian error");
             }
         }
 
@@ -633,7 +710,7 @@ namespace mp
             }
             else
             {
-                static_assert(0, "endian error");
+                static_assert(sizeof(T) == 0, "endian error");
             }
         }
 
@@ -664,6 +741,20 @@ namespace mp
 
     public:
         // Read
+        // Fetch consumes n bytes and returns a pointer to them, or nullptr if fewer are readable.
+        // The pointer stays valid until the next write; scratch is unused, the bytes are contiguous.
+        const char* Fetch(char* /*scratch*/, size_t n) noexcept
+        {
+            if (Size() < n)
+            {
+                return nullptr;
+            }
+
+            const char* p = Data();
+            read_index_ += n;
+            return p;
+        }
+
         bool Read(void* buf, size_t len) noexcept
         {
             if (Peek(buf, len))
@@ -752,10 +843,86 @@ namespace mp
             }
             else
             {
-                static_assert(0, "endian error");
+                static_assert(sizeof(T) == 0, "endian error");
+            }
+        }
+
+#if !defined(_WIN32)
+        // fd
+    public:
+        static const size_t kExtraReadSize = 65536;
+
+        // ReadFromFd drains fd with a single readv: into the writable space first, then into a
+        // 64 KiB stack area that is appended afterwards, so the buffer only grows by what arrived.
+        // Returns the bytes read, 0 on EOF, -1 on error with saved_errno set.
+        ssize_t ReadFromFd(int fd, int* saved_errno = nullptr)
+        {
+            char extra[kExtraReadSize];
+            struct iovec vec[2];
+            const size_t writable = WritableBytes();
+            vec[0].iov_base = WritePtr();
+            vec[0].iov_len = writable;
+            vec[1].iov_base = extra;
+            vec[1].iov_len = sizeof(extra);
+            // enough writable space already: don't read more than it
+            const int iovcnt = (writable < sizeof(extra)) ? 2 : 1;
+
+            const ssize_t n = ::readv(fd, vec, iovcnt);
+            if (n < 0)
+            {
+                if (saved_errno != nullptr)
+                {
+                    *saved_errno = errno;
+                }
+            }
+            else if (static_cast<size_t>(n) <= writable)
+            {
+                write_index_ += n;
+            }
+            else
+            {
+                write_index_ = capacity_;
+                Write(extra, n - writable);
             }
+
+            return n;
         }
 
+        // WriteToFd writes readable bytes until they are drained or fd would block,
+        // retrying partial writes. Returns the bytes written, -1 on error with saved_errno set.
+        ssize_t WriteToFd(int fd, int* saved_errno = nullptr)
+        {
+            ssize_t total = 0;
+            while (Size() > 0)
+            {
+                const ssize_t n = ::write(fd, Data(), Size());
+                if (n > 0)
+                {
+                    Consume(n);
+                    total += n;
+                }
+                else if (n < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                else if (n == 0 || errno == EAGAIN || errno == EWOULDBLOCK)
+                {
+                    break;
+                }
+                else
+                {
+                    if (saved_errno != nullptr)
+                    {
+                        *saved_errno = errno;
+                    }
+                    return -1;
+                }
+            }
+
+            return total;
+        }
+
+#endif
         // Helpers
     public:
         // ToText appends char '\0' to buffer to convert the underlying data to a c-style string text.
@@ -805,7 +972,29 @@ namespace mp
             return static_cast<const char*>(eol);
         }
 
+    protected:
+        // uses caller-provided storage until the first Grow(), which moves to the allocator
+        DataBuffer(char* storage, size_t capacity, size_t reserved_prepend_size, BufferAllocator* allocator) noexcept
+            : buffer_(storage)
+            , capacity_(capacity)
+            , read_index_(reserved_prepend_size)
+            , write_index_(reserved_prepend_size)
+            , reserved_prepend_size_(reserved_prepend_size)
+            , allocator_(allocator)
+            , owns_buffer_(false)
+        {
+            assert(capacity_ >= reserved_prepend_size_);
+        }
+
     private:
+        void ReleaseBuffer() noexcept
+        {
+            if (buffer_ != nullptr && owns_buffer_)
+            {
+                allocator_->Deallocate(buffer_, capacity_);
+            }
+        }
+
         char* Begin() noexcept
         {
             return buffer_;
@@ -834,13 +1023,14 @@ namespace mp
                 // grow the capacity
                 size_t n = (capacity_ << 1) + len;
                 size_t data_size = Size();
-                char* d = new char[n];
+                char* d = allocator_->Allocate(n);
                 memcpy(d + reserved_prepend_size_, Data(), data_size);
                 write_index_ = data_size + reserved_prepend_size_;
                 read_index_ = reserved_prepend_size_;
+                ReleaseBuffer();
                 capacity_ = n;
-                delete[] buffer_;
                 buffer_ = d;
+                owns_buffer_ = true;
             }
             else
             {
@@ -862,6 +1052,8 @@ namespace mp
         size_t write_index_;
         size_t reserved_prepend_size_;
         ByteOrder endian_ = ByteOrder::kNative;
+        BufferAllocator* allocator_;
+        bool owns_buffer_ = true;
         static constexpr char kCRLF[] = "\r\n";
     };
 
@@ -0,0 +1,291 @@
+#pragma once
+#include <assert.h>
+#include <cstdint>
+#include <string.h>
+#include "DataBuffer.hpp"
+#include "EndianConversion.hpp"
+#include <array>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace mp
+{
+    // DataBufferView is a read-only cursor over bytes it does not own
+    // (a recv ring, an mmap'd file, a shared-memory slot, a DataBuffer's readable bytes).
+    // It offers the Read/Peek API of DataBuffer without copying the bytes in first.
+    // The viewed memory must outlive the view and must not change while it is read.
+    class DataBufferView
+    {
+    public:
+        using ByteOrder = DataBuffer::ByteOrder;
+
+        DataBufferView() noexcept
+            : data_(nullptr)
+            , size_(0)
+            , read_index_(0)
+        {
+        }
+
+        DataBufferView(const void* data, size_t size) noexcept
+            : data_(static_cast<const char*>(data))
+            , size_(size)
+            , read_index_(0)
+        {
+        }
+
+        explicit DataBufferView(std::string_view sv) noexcept
+            : DataBufferView(sv.data(), sv.size())
+        {
+        }
+
+        // views the readable bytes of buffer; Consume() on the view does not consume the buffer
+        explicit DataBufferView(const DataBuffer& buffer) noexcept
+            : DataBufferView(buffer.Data(), buffer.Size())
+        {
+        }
+
+        // read ptr
+        const char* Data() const noexcept
+        {
+            return data_ + read_index_;
+        }
+
+        // readabe size
+        size_t Size() const noexcept
+        {
+            assert(size_ >= read_index_);
+            return size_ - read_index_;
+        }
+
+        // bytes consumed since the view was created or last rewound
+        size_t ConsumedBytes() const noexcept
+        {
+            return read_index_;
+        }
+
+        // Rewind makes every byte of the view readable again.
+        void Rewind() noexcept
+        {
+            read_index_ = 0;
+        }
+
+        void Consume(std::size_t n) noexcept
+        {
+            if (n <= Size())
+            {
+                read_index_ += n;
+            }
+            else
+            {
+                read_index_ = size_;
+            }
+        }
+
+        void ReverConsume(std::size_t n) noexcept
+        {
+            if (read_index_ >= n)
+            {
+                read_index_ -= n;
+            }
+            else
+            {
+                read_index_ = 0;
+            }
+        }
+
+        void SetEndian(ByteOrder byte_order) noexcept
+        {
+            endian_ = byte_order;
+        }
+
+        ByteOrder GetEndian() const noexcept
+        {
+            return endian_;
+        }
+
+        std::string_view ToStringView() const noexcept
+        {
+            return std::string_view(Data(), Size());
+        }
+
+        std::string ToString() const
+        {
+            return std::string(Data(), Size());
+        }
+
+    public:
+        // Peek
+        bool Peek(void* buf, size_t len) const noexcept
+        {
+            if (Size() < len)
+            {
+                return false;
+            }
+
+            memcpy(buf, Data(), len);
+
+            return true;
+        }
+
+        template <size_t N>
+        bool Peek(std::array<char, N>& array) const noexcept
+        {
+            return Peek(array.data(), N);
+        }
+
+        template <size_t N>
+        bool Peek(char(&array)[N]) const noexcept
+        {
+            return Peek(array, N);
+        }
+
+        template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        bool PeekInteger(T& value) const noexcept
+        {
+            return Peek(&value, sizeof(T));
+        }
+
+        template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        bool PeekIntegerLE(T& value) const noexcept
+        {
+            if (Peek(&value, sizeof(T)))
+            {
+                value = endian::letoh(value);
+                return true;
+            }
+
+            return false;
+        }
+
+        template <typename T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        bool PeekIntegerBE(T& value) const noexcept
+        {
+            if (Peek(&value, sizeof(T)))
+            {
+                value = endian::betoh(value);
+                return true;
+            }
+
+            return false;
+        }
+
+        template <ByteOrder byte_order = ByteOrder::kRuntime, typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        bool Peek(T& value) const noexcept
+        {
+            if constexpr (byte_order == ByteOrder::kNative)
+            {
+                return PeekInteger(value);
+            }
+            else if constexpr (byte_order == ByteOrder::kLittleEndian)
+            {
+                return PeekIntegerLE(value);
+            }
+            else if constexpr (byte_order == ByteOrder::kBigEndian)
+            {
+                return PeekIntegerBE(value);
+            }
+            else
+            {
+                if (endian_ == ByteOrder::kBigEndian)
+                {
+                    return PeekIntegerBE(value);
+                }
+                else if (endian_ == ByteOrder::kLittleEndian)
+                {
+                    return PeekIntegerLE(value);
+                }
+                else
+                {
+                    return PeekInteger(value);
+                }
+            }
+        }
+
+        template <typename T, ByteOrder byte_order = ByteOrder::kRuntime,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        std::optional<T> Peek() const noexcept
+        {
+            T value = 0;
+            if (Peek<byte_order>(value))
+            {
+                return value;
+            }
+
+            return {};
+        }
+
+    public:
+        // Read
+        // Fetch consumes n bytes and returns a pointer to them, or nullptr if fewer are readable.
+        const char* Fetch(char* /*scratch*/, size_t n) noexcept
+        {
+            if (Size() < n)
+            {
+                return nullptr;
+            }
+
+            const char* p = Data();
+            read_index_ += n;
+            return p;
+        }
+
+        bool Read(void* buf, size_t len) noexcept
+        {
+            if (Peek(buf, len))
+            {
+                read_index_ += len;
+                return true;
+            }
+
+            return false;
+        }
+
+        template <size_t N>
+        bool Read(std::array<char, N>& array) noexcept
+        {
+            return Read(array.data(), N);
+        }
+
+        template <size_t N>
+        bool Read(char(&array)[N]) noexcept
+        {
+            return Read(array, N);
+        }
+
+        template <ByteOrder byte_order = ByteOrder::kRuntime, typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        bool Read(T& value) noexcept
+        {
+            if (Peek<byte_order>(value))
+            {
+                read_index_ += sizeof(T);
+                return true;
+            }
+
+            return false;
+        }
+
+        // ReadView returns the next len bytes without copying them
+        bool ReadView(std::string_view& sv, size_t len) noexcept
+        {
+            if (Size() < len)
+            {
+                return false;
+            }
+
+            sv = std::string_view(Data(), len);
+            read_index_ += len;
+            return true;
+        }
+
+    private:
+        const char* data_;
+        size_t size_;
+        size_t read_index_;
+        ByteOrder endian_ = ByteOrder::kNative;
+    };
+
+} // namespace mp
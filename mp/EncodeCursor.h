@@ -0,0 +1,108 @@
+#pragma once
+#include <cstdint>
+#include <string.h>
+#include "DataBuffer.hpp"
+#include "EndianConversion.hpp"
+#include <array>
+#include <type_traits>
+
+namespace mp
+{
+    // EncodeCursor writes into memory that has already been sized for the whole message
+    // (see EncodeTo), so unlike DataBuffer it never grows. A write that does not fit is dropped
+    // and sets the overflow flag instead, one compare per write; EncodeTo then fails the encode.
+    class EncodeCursor
+    {
+    public:
+        using ByteOrder = DataBuffer::ByteOrder;
+
+        EncodeCursor(char* begin, size_t size) noexcept
+            : begin_(begin)
+            , cursor_(begin)
+            , end_(begin + size)
+        {
+        }
+
+        // written size
+        size_t Size() const noexcept
+        {
+            return static_cast<size_t>(cursor_ - begin_);
+        }
+
+        size_t WritableBytes() const noexcept
+        {
+            return static_cast<size_t>(end_ - cursor_);
+        }
+
+        void SetEndian(ByteOrder byte_order) noexcept
+        {
+            endian_ = byte_order;
+        }
+
+        ByteOrder GetEndian() const noexcept
+        {
+            return endian_;
+        }
+
+        // true once a write did not fit; nothing past that point was written
+        bool Overflowed() const noexcept
+        {
+            return overflowed_;
+        }
+
+    public:
+        // Write
+        void Write(const void* buf, size_t len) noexcept
+        {
+            if (len > WritableBytes())
+            {
+                overflowed_ = true;
+                return;
+            }
+
+            memcpy(cursor_, buf, len);
+            cursor_ += len;
+        }
+
+        template <size_t N>
+        void Write(const std::array<char, N>& array) noexcept
+        {
+            Write(array.data(), N);
+        }
+
+        template <ByteOrder byte_order = ByteOrder::kRuntime, typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        void Write(T value) noexcept
+        {
+            if constexpr (byte_order == ByteOrder::kLittleEndian)
+            {
+                value = endian::htole(value);
+            }
+            else if constexpr (byte_order == ByteOrder::kBigEndian)
+            {
+                value = endian::htobe(value);
+            }
+            else if constexpr (byte_order == ByteOrder::kRuntime)
+            {
+                if (endian_ == ByteOrder::kBigEndian)
+                {
+                    value = endian::htobe(value);
+                }
+                else if (endian_ == ByteOrder::kLittleEndian)
+                {
+                    value = endian::htole(value);
+                }
+            }
+
+            Write(&value, sizeof(value));
+        }
+
+    private:
+        char* begin_;
+        char* cursor_;
+        char* end_;
+        ByteOrder endian_ = ByteOrder::kNative;
+        bool overflowed_ = false;
+    };
+
+} // namespace mp
@@ -2,8 +2,17 @@
 
 #include <cassert>
 #include <algorithm>
+#include <cstddef>
 #include <type_traits>
 
+#if __has_include(<bit>)
+#   include <bit>
+#endif
+
+#if defined(_MSC_VER)
+#   include <stdlib.h>
+#endif
+
 #if defined (__GLIBC__)
 #   include <endian.h>
 #endif
@@ -40,87 +49,126 @@ namespace mp
         enum { xinu_type = 0, unix_type = 1, nuxi_type = 2, type = nuxi_type, is_little = 0, is_big = 0 };
 #endif
 
-        template<typename T>
-        T swap(T out)
+        namespace detail
         {
-            static union autodetect {
-                int word;
-                char byte[sizeof(int)];
-                autodetect() : word(1) {
-                    assert(("<giant/giant.hpp> says: wrong endianness detected!", (!byte[0] && is_big) || (byte[0] && is_little)));
+            // portable fallback, also used where the intrinsic is not constexpr
+            template<typename U>
+            constexpr U byteswap_shift(U in) noexcept {
+                U out = 0;
+                for (std::size_t i = 0; i < sizeof(U); ++i) {
+                    out = static_cast<U>((out << 8) | (in & 0xff));
+                    in = static_cast<U>(in >> 8);
                 }
-            } _;
-
-            if (!std::is_standard_layout<T>::value) {
                 return out;
             }
 
-            char* ptr;
-
-            switch (sizeof(T)) {
-            case 0:
-            case 1:
-                break;
-            case 2:
-                ptr = reinterpret_cast<char*>(&out);
-                std::swap(ptr[0], ptr[1]);
-                break;
-            case 4:
-                ptr = reinterpret_cast<char*>(&out);
-                std::swap(ptr[0], ptr[3]);
-                std::swap(ptr[1], ptr[2]);
-                break;
-            case 8:
-                ptr = reinterpret_cast<char*>(&out);
-                std::swap(ptr[0], ptr[7]);
-                std::swap(ptr[1], ptr[6]);
-                std::swap(ptr[2], ptr[5]);
-                std::swap(ptr[3], ptr[4]);
-                break;
-            case 16:
-                ptr = reinterpret_cast<char*>(&out);
-                std::swap(ptr[0], ptr[15]);
-                std::swap(ptr[1], ptr[14]);
-                std::swap(ptr[2], ptr[13]);
-                std::swap(ptr[3], ptr[12]);
-                std::swap(ptr[4], ptr[11]);
-                std::swap(ptr[5], ptr[10]);
-                std::swap(ptr[6], ptr[9]);
-                std::swap(ptr[7], ptr[8]);
-                break;
-            default:
-                assert(!" says: POD type bigger than 256 bits (?)");
-                break;
+            template<typename U>
+            constexpr U byteswap(U in) noexcept {
+                static_assert(std::is_unsigned<U>::value, "byteswap expects an unsigned integer");
+#if defined(__cpp_lib_byteswap)
+                return std::byteswap(in);
+#elif defined(__GNUC__) || defined(__clang__)
+                if constexpr (sizeof(U) == 2) {
+                    return __builtin_bswap16(in);
+                }
+                else if constexpr (sizeof(U) == 4) {
+                    return __builtin_bswap32(in);
+                }
+                else if constexpr (sizeof(U) == 8) {
+                    return __builtin_bswap64(in);
+                }
+                else {
+                    return byteswap_shift(in);
+                }
+#elif defined(_MSC_VER) && defined(__cpp_lib_is_constant_evaluated)
+                // _byteswap_* are not constexpr
+                if (std::is_constant_evaluated()) {
+                    return byteswap_shift(in);
+                }
+                if constexpr (sizeof(U) == 2) {
+                    return _byteswap_ushort(in);
+                }
+                else if constexpr (sizeof(U) == 4) {
+                    return _byteswap_ulong(in);
+                }
+                else if constexpr (sizeof(U) == 8) {
+                    return _byteswap_uint64(in);
+                }
+                else {
+                    return byteswap_shift(in);
+                }
+#else
+                // MSVC before C++20 cannot tell constant evaluation apart, so no _byteswap_* here
+                return byteswap_shift(in);
+#endif
             }
+        }
 
-            return out;
+        template<typename T>
+        constexpr T swap(T out) noexcept {
+            if constexpr (sizeof(T) == 1 || !std::is_standard_layout<T>::value) {
+                return out;
+            }
+            else if constexpr (std::is_integral<T>::value) {
+                return static_cast<T>(detail::byteswap(static_cast<typename std::make_unsigned<T>::type>(out)));
+            }
+            else if constexpr (std::is_enum<T>::value) {
+                return static_cast<T>(swap(static_cast<typename std::underlying_type<T>::type>(out)));
+            }
+            else {
+                // float, POD structs: reverse the object bytes
+                char* ptr = reinterpret_cast<char*>(&out);
+                std::reverse(ptr, ptr + sizeof(T));
+                return out;
+            }
         }
 
         template<typename T>
-        T letobe(const T& in) {
+        constexpr T letobe(const T& in) noexcept {
             return swap(in);
         }
         template<typename T>
-        T betole(const T& in) {
+        constexpr T betole(const T& in) noexcept {
             return swap(in);
         }
 
+        // no-ops on a matching host, a single bswap otherwise
         template<typename T>
-        T letoh(const T& in) {
-            return type == xinu_type ? in : swap(in);
+        constexpr T letoh(const T& in) noexcept {
+            if constexpr (type == xinu_type) {
+                return in;
+            }
+            else {
+                return swap(in);
+            }
         }
         template<typename T>
-        T htole(const T& in) {
-            return type == xinu_type ? in : swap(in);
+        constexpr T htole(const T& in) noexcept {
+            if constexpr (type == xinu_type) {
+                return in;
+            }
+            else {
+                return swap(in);
+            }
         }
 
         template<typename T>
-        T betoh(const T& in) {
-            return type == unix_type ? in : swap(in);
+        constexpr T betoh(const T& in) noexcept {
+            if constexpr (type == unix_type) {
+                return in;
+            }
+            else {
+                return swap(in);
+            }
         }
         template<typename T>
-        T htobe(const T& in) {
-            return type == unix_type ? in : swap(in);
+        constexpr T htobe(const T& in) noexcept {
+            if constexpr (type == unix_type) {
+                return in;
+            }
+            else {
+                return swap(in);
+            }
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,94 @@
+#pragma once
+#include <cstdint>
+#include <string.h>
+#include "MpTypes.h"
+#include "DataBuffer.hpp"
+#include "EndianConversion.hpp"
+
+namespace mp
+{
+    // FrameHeader is the wire prefix of every frame, laid out like the schema's Header message:
+    // message_type then body_length, both uint32, followed by body_length bytes of message body.
+    // kSize equals DataBuffer::kCheapPrependSize, so a header can be written in front of an
+    // already encoded body without moving it.
+    struct FrameHeader
+    {
+        static constexpr size_t kSize = sizeof(uint32_t) + sizeof(uint32_t);
+
+        MsgType_Def message_type = 0;
+        uint32_t body_length = 0;
+
+        // same byte order rules as MessageDecoder::Read, kRuntime follows host_to_network_byte_order
+        template <DataBuffer::ByteOrder byte_order>
+        static FrameHeader Load(const char* p, bool host_to_network_byte_order = true) noexcept
+        {
+            FrameHeader header;
+            memcpy(&header.message_type, p, sizeof(uint32_t));
+            memcpy(&header.body_length, p + sizeof(uint32_t), sizeof(uint32_t));
+            header.message_type = ToHost<byte_order>(header.message_type, host_to_network_byte_order);
+            header.body_length = ToHost<byte_order>(header.body_length, host_to_network_byte_order);
+            return header;
+        }
+
+        // p must hold kSize bytes
+        template <DataBuffer::ByteOrder byte_order>
+        void Store(char* p, bool host_to_network_byte_order = true) const noexcept
+        {
+            uint32_t message_type_wire = ToWire<byte_order>(message_type, host_to_network_byte_order);
+            uint32_t body_length_wire = ToWire<byte_order>(body_length, host_to_network_byte_order);
+            memcpy(p, &message_type_wire, sizeof(uint32_t));
+            memcpy(p + sizeof(uint32_t), &body_length_wire, sizeof(uint32_t));
+        }
+
+        size_t FrameSize() const noexcept
+        {
+            return kSize + body_length;
+        }
+
+    private:
+        template <DataBuffer::ByteOrder byte_order>
+        static uint32_t ToHost(uint32_t value, bool host_to_network_byte_order) noexcept
+        {
+            if constexpr (byte_order == DataBuffer::ByteOrder::kLittleEndian)
+            {
+                return endian::letoh(value);
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kBigEndian)
+            {
+                return endian::betoh(value);
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kRuntime)
+            {
+                return host_to_network_byte_order ? endian::betoh(value) : value;
+            }
+            else
+            {
+                return value;
+            }
+        }
+
+        template <DataBuffer::ByteOrder byte_order>
+        static uint32_t ToWire(uint32_t value, bool host_to_network_byte_order) noexcept
+        {
+            if constexpr (byte_order == DataBuffer::ByteOrder::kLittleEndian)
+            {
+                return endian::htole(value);
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kBigEndian)
+            {
+                return endian::htobe(value);
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kRuntime)
+            {
+                return host_to_network_byte_order ? endian::htobe(value) : value;
+            }
+            else
+            {
+                return value;
+            }
+        }
+    };
+
+    static_assert(FrameHeader::kSize == DataBuffer::kCheapPrependSize, "FrameHeader must fit the cheap prepend area");
+
+} // namespace mp
@@ -0,0 +1,44 @@
+#pragma once
+#include "DataBuffer.hpp"
+
+namespace mp
+{
+    // InlineDataBuffer keeps up to N bytes (plus the cheap prepend area) inside the object,
+    // so encoding a small message into a stack-local buffer does not allocate.
+    // Writing past N moves the bytes to the allocator, after which it behaves like DataBuffer.
+    // It can be passed wherever a DataBuffer& is expected (MessageEncoder, MessageDecoder).
+    template <size_t N>
+    class InlineDataBuffer : public DataBuffer
+    {
+    public:
+        static const size_t kInlineSize = N;
+
+        explicit InlineDataBuffer(BufferAllocator* allocator = DefaultBufferAllocator()) noexcept
+            : DataBuffer(storage_, sizeof(storage_), kCheapPrependSize, allocator)
+        {
+        }
+
+        InlineDataBuffer(const InlineDataBuffer&) = delete;
+
+        InlineDataBuffer& operator=(const InlineDataBuffer&) = delete;
+
+        // takes over other's heap storage, or copies its inline bytes into ours; inline bytes
+        // always fit in our own N bytes (or in the larger heap buffer we moved to), so unlike
+        // DataBuffer's moves these never allocate
+        InlineDataBuffer(InlineDataBuffer&& other) noexcept
+            : InlineDataBuffer(other.GetAllocator())
+        {
+            DataBuffer::operator=(static_cast<DataBuffer&&>(other));
+        }
+
+        InlineDataBuffer& operator=(InlineDataBuffer&& other) noexcept
+        {
+            DataBuffer::operator=(static_cast<DataBuffer&&>(other));
+            return *this;
+        }
+
+    private:
+        alignas(8) char storage_[kCheapPrependSize + N];
+    };
+
+} // namespace mp
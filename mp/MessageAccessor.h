@@ -0,0 +1,83 @@
+#pragma once
+#include <cstdint>
+#include <string.h>
+#include "DataBuffer.hpp"
+#include "EndianConversion.hpp"
+#include <array>
+#include <type_traits>
+
+namespace mp
+{
+    // MessageAccessor is the base of the generated XxxAccessor classes, which read single
+    // fields straight out of encoded message bytes instead of Decode()ing the whole message.
+    // It does not own the bytes; they must outlive the accessor.
+    class MessageAccessor
+    {
+    public:
+        MessageAccessor(const char* data, size_t size, bool host_to_network_byte_order = true) noexcept
+            : data_(data)
+            , size_(size)
+            , host_to_network_byte_order_(host_to_network_byte_order)
+        {
+        }
+
+        const char* Data() const noexcept
+        {
+            return data_;
+        }
+
+        size_t Size() const noexcept
+        {
+            return size_;
+        }
+
+    protected:
+        // same byte order rules as MessageDecoder::Read, kRuntime follows host_to_network_byte_order
+        template <DataBuffer::ByteOrder byte_order, typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        static void Load(const char* p, bool host_to_network_byte_order, T& value) noexcept
+        {
+            memcpy(&value, p, sizeof(T));
+            if constexpr (byte_order == DataBuffer::ByteOrder::kLittleEndian)
+            {
+                value = endian::letoh(value);
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kBigEndian)
+            {
+                value = endian::betoh(value);
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kRuntime)
+            {
+                if (host_to_network_byte_order)
+                {
+                    value = endian::betoh(value);
+                }
+            }
+        }
+
+        template <DataBuffer::ByteOrder byte_order, size_t N>
+        static void Load(const char* p, bool /*host_to_network_byte_order*/, std::array<char, N>& value) noexcept
+        {
+            memcpy(value.data(), p, N);
+        }
+
+        // reads the uint32 length or count prefix of a STRING or Sequence, false if truncated
+        template <DataBuffer::ByteOrder byte_order>
+        static bool LoadLength(const char* p, size_t remaining, bool host_to_network_byte_order, uint32_t& length) noexcept
+        {
+            if (remaining < sizeof(uint32_t))
+            {
+                return false;
+            }
+
+            Load<byte_order>(p, host_to_network_byte_order, length);
+            return true;
+        }
+
+    protected:
+        const char* data_;
+        size_t size_;
+        bool host_to_network_byte_order_;
+    };
+
+} // namespace mp
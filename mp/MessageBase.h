@@ -8,14 +8,28 @@
 namespace mp
 {
 
-    class MessageDecoder;
-    class MessageEncoder;
+    class DataBuffer;
+    class SegmentedDataBuffer;
+    class DataBufferView;
+    class EncodeCursor;
+
+    template<typename Buffer>
+    class BasicMessageDecoder;
+    template<typename Buffer>
+    class BasicMessageEncoder;
+
+    using MessageDecoder = BasicMessageDecoder<DataBuffer>;
+    using SegmentedMessageDecoder = BasicMessageDecoder<SegmentedDataBuffer>;
+    using MessageViewDecoder = BasicMessageDecoder<DataBufferView>;
+    using MessageEncoder = BasicMessageEncoder<DataBuffer>;
+    using SegmentedMessageEncoder = BasicMessageEncoder<SegmentedDataBuffer>;
+    using CursorMessageEncoder = BasicMessageEncoder<EncodeCursor>;
 
     class MessageBase
     {
     public:
-        MessageBase() {}
-        virtual ~MessageBase() {}
+        MessageBase() = default;
+        virtual ~MessageBase() = default;
 
         std::string ToString()
         {
@@ -26,17 +40,39 @@ namespace mp
 
         virtual void FillDefaultValue() = 0;
 
+        // resets every field; strings and sequences are emptied but keep their capacity,
+        // so a long-lived message reused for each decode stops allocating once warmed up
+        virtual void Clear() = 0;
+
         virtual MsgType_Def GetMsgType() = 0;
 
         virtual uint32_t GetMsgSize() = 0;
 
+        // Decode overwrites an existing instance: every field is assigned, strings and sequences
+        // are resized to the decoded length and their existing storage and elements are reused.
+        // Clear() is not needed between decodes. After a failed Decode the fields are unspecified.
         virtual mp::ErrorCode Decode(mp::MessageDecoder& decoder) = 0;
 
+        virtual mp::ErrorCode Decode(mp::SegmentedMessageDecoder& decoder) = 0;
+
+        // decodes straight from memory the caller owns, see DataBufferView
+        virtual mp::ErrorCode Decode(mp::MessageViewDecoder& decoder) = 0;
+
         virtual mp::ErrorCode Encode(mp::MessageEncoder& encoder) = 0;
 
-        virtual void Dump(std::ostream& ostream) = 0;
+        virtual mp::ErrorCode Encode(mp::SegmentedMessageEncoder& encoder) = 0;
 
+        // used by EncodeTo, see MessageEncoder.h
+        virtual mp::ErrorCode Encode(mp::CursorMessageEncoder& encoder) = 0;
+
+        virtual void Dump(std::ostream& ostream) = 0;
 
+    protected:
+        // the user-declared virtual destructor would otherwise leave generated messages copy-only
+        MessageBase(const MessageBase&) = default;
+        MessageBase(MessageBase&&) noexcept = default;
+        MessageBase& operator=(const MessageBase&) = default;
+        MessageBase& operator=(MessageBase&&) noexcept = default;
     };
 
 }
\ No newline at end of file
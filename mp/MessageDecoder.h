@@ -4,13 +4,19 @@
 
 #include"MpTypes.h"
 #include"DataBuffer.hpp"
+#include"SegmentedDataBuffer.hpp"
+#include"DataBufferView.hpp"
+#include"BulkByteSwap.h"
+#include<vector>
+#include<string.h>
 
 namespace mp
 {
-    class MessageDecoder
+    template<typename Buffer>
+    class BasicMessageDecoder
     {
     public:
-        MessageDecoder(DataBuffer& data_buffer, bool host_to_network_byte_order = true) : data_buffer_(data_buffer),
+        BasicMessageDecoder(Buffer& data_buffer, bool host_to_network_byte_order = true) : data_buffer_(data_buffer),
             host_to_network_byte_order_(host_to_network_byte_order)
         {
 
@@ -21,7 +27,7 @@ namespace mp
         {
             if (host_to_network_byte_order_)
             {
-                return data_buffer_.Read<DataBuffer::kBigEndian>(value) ? ErrorCode::kSuccess : ErrorCode::kReadError;
+                return data_buffer_.template Read<DataBuffer::ByteOrder::kBigEndian>(value) ? ErrorCode::kSuccess : ErrorCode::kReadError;
             }
             else
             {
@@ -29,6 +35,128 @@ namespace mp
             }
         }
 
+        // byte order fixed at compile time (generated code passes the schema's kByteOrder);
+        // kRuntime falls back to host_to_network_byte_order_
+        template<DataBuffer::ByteOrder byte_order, typename T, typename std::enable_if <std::is_integral<T>::value, int >::type = 0 >
+        ErrorCode Read(T& value)
+        {
+            if constexpr (byte_order == DataBuffer::ByteOrder::kRuntime)
+            {
+                return Read(value);
+            }
+            else
+            {
+                return data_buffer_.template Read<byte_order>(value) ? ErrorCode::kSuccess : ErrorCode::kReadError;
+            }
+        }
+
+        // Fetch takes n bytes with a single bounds check; generated code then Load()s a run of
+        // fixed-size fields from constant offsets. scratch must hold n bytes.
+        const char* Fetch(char* scratch, size_t n) noexcept
+        {
+            return data_buffer_.Fetch(scratch, n);
+        }
+
+        template<DataBuffer::ByteOrder byte_order, typename T, typename std::enable_if <std::is_integral<T>::value, int >::type = 0 >
+        void Load(const char* p, T& value) noexcept
+        {
+            memcpy(&value, p, sizeof(T));
+            value = FromWire<byte_order>(value);
+        }
+
+        template<DataBuffer::ByteOrder byte_order, std::size_t N>
+        void Load(const char* p, std::array<char, N>& value) noexcept
+        {
+            memcpy(value.data(), p, N);
+        }
+
+        // FromWire converts a value already copied out of the buffer to host byte order
+        template<DataBuffer::ByteOrder byte_order, typename T, typename std::enable_if <std::is_integral<T>::value, int >::type = 0 >
+        T FromWire(T value) const noexcept
+        {
+            if constexpr (byte_order == DataBuffer::ByteOrder::kLittleEndian)
+            {
+                return endian::letoh(value);
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kBigEndian)
+            {
+                return endian::betoh(value);
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kRuntime)
+            {
+                // same rules as Read(T&)
+                if (host_to_network_byte_order_ || data_buffer_.GetEndian() == DataBuffer::ByteOrder::kBigEndian)
+                {
+                    return endian::betoh(value);
+                }
+                else if (data_buffer_.GetEndian() == DataBuffer::ByteOrder::kLittleEndian)
+                {
+                    return endian::letoh(value);
+                }
+            }
+
+            return value;
+        }
+
+        template<DataBuffer::ByteOrder byte_order, std::size_t N>
+        const std::array<char, N>& FromWire(const std::array<char, N>& value) const noexcept
+        {
+            return value;
+        }
+
+        // CheckCount rejects a length or element count read off the wire that the remaining bytes
+        // cannot hold, before anything is reserved or resized for it
+        bool CheckCount(uint32_t count, size_t min_item_size) const noexcept
+        {
+            return static_cast<uint64_t>(count) * min_item_size <= data_buffer_.Size();
+        }
+
+        // ReadSequence reads count integers with one bounds check and one copy,
+        // then byte-swaps them in bulk. values is resized to count.
+        template<DataBuffer::ByteOrder byte_order, typename T,
+            typename std::enable_if <std::is_integral<T>::value && !std::is_same<T, bool>::value, int >::type = 0 >
+        ErrorCode ReadSequence(std::vector<T>& values, uint32_t count)
+        {
+            size_t bytes = static_cast<size_t>(count) * sizeof(T);
+            if (data_buffer_.Size() < bytes)
+            {
+                return ErrorCode::kReadError;
+            }
+
+            if (count == 0)
+            {
+                values.clear();
+                return ErrorCode::kSuccess;
+            }
+
+            if (byte_order == DataBuffer::ByteOrder::kRuntime && !host_to_network_byte_order_)
+            {
+                // byte order is up to the buffer, element by element
+                values.resize(count);
+                for (auto& value : values)
+                {
+                    if (!data_buffer_.Read(value))
+                    {
+                        return ErrorCode::kReadError;
+                    }
+                }
+                return ErrorCode::kSuccess;
+            }
+
+            values.resize(count);
+            if (!data_buffer_.Read(values.data(), bytes))
+            {
+                return ErrorCode::kReadError;
+            }
+
+            if (NeedsByteSwap<byte_order>())
+            {
+                ByteSwapInPlace(values.data(), values.size());
+            }
+
+            return ErrorCode::kSuccess;
+        }
+
         template<std::size_t N>
         ErrorCode Read(std::array<char, N>& value)
         {
@@ -46,8 +174,58 @@ namespace mp
             return data_buffer_.Read(p, size) ? ErrorCode::kSuccess : ErrorCode::kReadError;
         }
 
+        // ReadView points value at the next size bytes instead of copying them;
+        // only buffers that outlive the decoded message provide it (DataBufferView)
+        ErrorCode ReadView(std::string_view& value, uint32_t size)
+        {
+            return data_buffer_.ReadView(value, size) ? ErrorCode::kSuccess : ErrorCode::kReadError;
+        }
+
+        // STRING field of size bytes, so one generated decode serves messages and Views:
+        // a std::string is resized (keeping its capacity) and filled, a std::string_view uses ReadView
+        ErrorCode ReadString(std::string& value, uint32_t size)
+        {
+            if (!CheckCount(size, 1))
+            {
+                return ErrorCode::kReadError;
+            }
+
+            value.resize(size);
+            return Read(value.data(), size);
+        }
+
+        ErrorCode ReadString(std::string_view& value, uint32_t size)
+        {
+            return ReadView(value, size);
+        }
+
     private:
-        DataBuffer& data_buffer_;
+        template<DataBuffer::ByteOrder byte_order>
+        bool NeedsByteSwap() const noexcept
+        {
+            if constexpr (byte_order == DataBuffer::ByteOrder::kNative)
+            {
+                return false;
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kLittleEndian)
+            {
+                return endian::is_big;
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kBigEndian)
+            {
+                return !endian::is_big;
+            }
+            else
+            {
+                return host_to_network_byte_order_ && !endian::is_big;
+            }
+        }
+
+        Buffer& data_buffer_;
         bool host_to_network_byte_order_;
     };
+
+    using MessageDecoder = BasicMessageDecoder<DataBuffer>;
+    using SegmentedMessageDecoder = BasicMessageDecoder<SegmentedDataBuffer>;
+    using MessageViewDecoder = BasicMessageDecoder<DataBufferView>;
 }
\ No newline at end of file
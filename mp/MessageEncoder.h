@@ -4,13 +4,21 @@
 
 #include"MpTypes.h"
 #include"DataBuffer.hpp"
+#include"SegmentedDataBuffer.hpp"
+#include"EncodeCursor.h"
+#include"FrameHeader.h"
+#include"MessageBase.h"
+#include"BulkByteSwap.h"
+#include<algorithm>
+#include<cstring>
 
 namespace mp
 {
-    class MessageEncoder
+    template<typename Buffer>
+    class BasicMessageEncoder
     {
     public:
-        MessageEncoder(DataBuffer& data_buffer, bool host_to_network_byte_order = true) : data_buffer_(data_buffer),
+        BasicMessageEncoder(Buffer& data_buffer, bool host_to_network_byte_order = true) : data_buffer_(data_buffer),
             host_to_network_byte_order_(host_to_network_byte_order)
         {
 
@@ -22,7 +30,7 @@ namespace mp
 
             if (host_to_network_byte_order_)
             {
-                data_buffer_.Write<DataBuffer::kBigEndian>(value);
+                data_buffer_.template Write<DataBuffer::ByteOrder::kBigEndian>(value);
             }
             else
             {
@@ -32,7 +40,23 @@ namespace mp
             return ErrorCode::kSuccess;
         }
 
-        template<uint32_t N>
+        // byte order fixed at compile time (generated code passes the schema's kByteOrder);
+        // kRuntime falls back to host_to_network_byte_order_
+        template<DataBuffer::ByteOrder byte_order, typename T, typename std::enable_if <std::is_integral<T>::value, int >::type = 0 >
+        ErrorCode Write(T value)
+        {
+            if constexpr (byte_order == DataBuffer::ByteOrder::kRuntime)
+            {
+                return Write(value);
+            }
+            else
+            {
+                data_buffer_.template Write<byte_order>(value);
+                return ErrorCode::kSuccess;
+            }
+        }
+
+        template<std::size_t N>
         ErrorCode Write(const std::array<char, N>& value)
         {
             return Write(value.data(), N);
@@ -50,8 +74,187 @@ namespace mp
 
             return ErrorCode::kSuccess;
         }
+
+        // ToWire converts a value to the byte order it is written in, for callers that lay out
+        // several fields themselves and then Write() them at once
+        template<DataBuffer::ByteOrder byte_order, typename T, typename std::enable_if <std::is_integral<T>::value, int >::type = 0 >
+        T ToWire(T value) const noexcept
+        {
+            if constexpr (byte_order == DataBuffer::ByteOrder::kLittleEndian)
+            {
+                return endian::htole(value);
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kBigEndian)
+            {
+                return endian::htobe(value);
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kRuntime)
+            {
+                // same rules as Write(T)
+                if (host_to_network_byte_order_ || data_buffer_.GetEndian() == DataBuffer::ByteOrder::kBigEndian)
+                {
+                    return endian::htobe(value);
+                }
+                else if (data_buffer_.GetEndian() == DataBuffer::ByteOrder::kLittleEndian)
+                {
+                    return endian::htole(value);
+                }
+            }
+
+            return value;
+        }
+
+        template<DataBuffer::ByteOrder byte_order, std::size_t N>
+        const std::array<char, N>& ToWire(const std::array<char, N>& value) const noexcept
+        {
+            return value;
+        }
+
+        // WriteSequence writes count integers, byte-swapping them in bulk through a stack block
+        // instead of converting and appending one element at a time.
+        template<DataBuffer::ByteOrder byte_order, typename T,
+            typename std::enable_if <std::is_integral<T>::value && !std::is_same<T, bool>::value, int >::type = 0 >
+        ErrorCode WriteSequence(const T* values, size_t count)
+        {
+            if (count == 0)
+            {
+                return ErrorCode::kSuccess;
+            }
+
+            if (byte_order == DataBuffer::ByteOrder::kRuntime && !host_to_network_byte_order_)
+            {
+                // byte order is up to the buffer, element by element
+                for (size_t i = 0; i < count; ++i)
+                {
+                    data_buffer_.Write(values[i]);
+                }
+                return ErrorCode::kSuccess;
+            }
+
+            if (!NeedsByteSwap<byte_order>())
+            {
+                data_buffer_.Write(values, count * sizeof(T));
+                return ErrorCode::kSuccess;
+            }
+
+            T block[kSwapBlockSize / sizeof(T)];
+            const size_t block_count = sizeof(block) / sizeof(T);
+            for (size_t i = 0; i < count; i += block_count)
+            {
+                size_t n = std::min(block_count, count - i);
+                memcpy(block, values + i, n * sizeof(T));
+                ByteSwapInPlace(block, n);
+                data_buffer_.Write(block, n * sizeof(T));
+            }
+
+            return ErrorCode::kSuccess;
+        }
+
     private:
-        DataBuffer& data_buffer_;
+        static const size_t kSwapBlockSize = 1024;
+
+        template<DataBuffer::ByteOrder byte_order>
+        bool NeedsByteSwap() const noexcept
+        {
+            if constexpr (byte_order == DataBuffer::ByteOrder::kNative)
+            {
+                return false;
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kLittleEndian)
+            {
+                return endian::is_big;
+            }
+            else if constexpr (byte_order == DataBuffer::ByteOrder::kBigEndian)
+            {
+                return !endian::is_big;
+            }
+            else
+            {
+                return host_to_network_byte_order_ && !endian::is_big;
+            }
+        }
+
+        Buffer& data_buffer_;
         bool host_to_network_byte_order_;
     };
+
+    using MessageEncoder = BasicMessageEncoder<DataBuffer>;
+    using SegmentedMessageEncoder = BasicMessageEncoder<SegmentedDataBuffer>;
+    using CursorMessageEncoder = BasicMessageEncoder<EncodeCursor>;
+
+    // EncodeTo reserves exactly msg_size bytes in buffer once and encodes message through a
+    // cursor that never grows, instead of checking capacity (and possibly growing) on every field.
+    // msg_size must be message.GetMsgSize(); pass it when the caller has computed it already.
+    // If the encoded size differs from msg_size (a wrong size, or a GetMsgSize() that disagrees
+    // with Encode) nothing is committed and kWriteError is returned.
+    inline ErrorCode EncodeTo(MessageBase& message, DataBuffer& buffer, uint32_t msg_size, bool host_to_network_byte_order = true)
+    {
+        buffer.Prepare(msg_size);
+        EncodeCursor cursor(buffer.WritePtr(), msg_size);
+        cursor.SetEndian(buffer.GetEndian());
+
+        CursorMessageEncoder encoder(cursor, host_to_network_byte_order);
+        ErrorCode ec = message.Encode(encoder);
+        if (ec != ErrorCode::kSuccess)
+        {
+            return ec;
+        }
+
+        if (cursor.Overflowed() || cursor.Size() != msg_size)
+        {
+            return ErrorCode::kWriteError;
+        }
+
+        buffer.Commit(cursor.Size());
+        return ec;
+    }
+
+    inline ErrorCode EncodeTo(MessageBase& message, DataBuffer& buffer, bool host_to_network_byte_order = true)
+    {
+        return EncodeTo(message, buffer, message.GetMsgSize(), host_to_network_byte_order);
+    }
+
+    // EncodeFrame appends message to buffer as one frame, FrameHeader then body, in a single
+    // pass; body_length is msg_size, so the header is known before the body is encoded.
+    // When buffer is empty and already has room for the body, the body is encoded with EncodeTo
+    // right after the prepend area and the header then written into that area; otherwise (the
+    // buffer holds data, has a prepend area under kSize, or would grow and so move its read
+    // index) the header is appended just before the body. Either way the frame is contiguous
+    // and ready to send, no second buffer, no copy.
+    // byte_order is the header byte order and must be the schema's kByteOrder, which is what the
+    // peer's framer reads with; generated code has <File>EncodeFrame bound to it.
+    template<DataBuffer::ByteOrder byte_order>
+    ErrorCode EncodeFrame(MessageBase& message, DataBuffer& buffer, uint32_t msg_size, bool host_to_network_byte_order = true)
+    {
+        FrameHeader header;
+        header.message_type = message.GetMsgType();
+        header.body_length = msg_size;
+        char header_wire[FrameHeader::kSize];
+        header.Store<byte_order>(header_wire, host_to_network_byte_order);
+
+        if (buffer.Size() == 0 && buffer.PrependableBytes() >= FrameHeader::kSize && buffer.WritableBytes() >= msg_size)
+        {
+            ErrorCode ec = EncodeTo(message, buffer, msg_size, host_to_network_byte_order);
+            if (ec != ErrorCode::kSuccess || buffer.WriteFront(header_wire, FrameHeader::kSize))
+            {
+                return ec;
+            }
+            // no header in front of the body: drop it and append both
+            buffer.ReverCommit(msg_size);
+        }
+
+        buffer.Write(header_wire, FrameHeader::kSize);
+        ErrorCode ec = EncodeTo(message, buffer, msg_size, host_to_network_byte_order);
+        if (ec != ErrorCode::kSuccess)
+        {
+            buffer.ReverCommit(FrameHeader::kSize);
+        }
+        return ec;
+    }
+
+    template<DataBuffer::ByteOrder byte_order>
+    ErrorCode EncodeFrame(MessageBase& message, DataBuffer& buffer, bool host_to_network_byte_order = true)
+    {
+        return EncodeFrame<byte_order>(message, buffer, message.GetMsgSize(), host_to_network_byte_order);
+    }
 }
\ No newline at end of file
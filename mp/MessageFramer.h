@@ -0,0 +1,147 @@
+#pragma once
+#include <cstdint>
+#include "MpTypes.h"
+#include "DataBuffer.hpp"
+#include "FrameHeader.h"
+
+namespace mp
+{
+    // largest body a MessageFramer accepts unless told otherwise; the buffer grows to hold a
+    // whole frame, so this bounds what one header can make a connection allocate
+    static const uint32_t kDefaultMaxBodyLength = 16 * 1024 * 1024;
+
+    enum class FrameStatus
+    {
+        kFrame,     // a complete frame was returned
+        kNeedMore,  // the pending frame is incomplete, read more bytes into the buffer
+        kOversized, // body_length exceeds max_body_length or the type's max_wire_size
+        kInvalid    // message_type is unknown or body_length is below the type's min_wire_size
+    };
+    // after kOversized or kInvalid the stream cannot be trusted any more: close the connection,
+    // or discard the buffered bytes and call Reset()
+
+    // Frame is a view of one complete frame inside the framer's DataBuffer. It does not own the
+    // bytes and stays valid only until the buffer is written to again (a write may move them).
+    struct Frame
+    {
+        FrameHeader header;
+        const char* data = nullptr; // header followed by body
+
+        const char* Body() const noexcept
+        {
+            return data + FrameHeader::kSize;
+        }
+
+        size_t Size() const noexcept
+        {
+            return header.FrameSize();
+        }
+    };
+
+    // MessageFramer cuts FrameHeader-prefixed frames out of the bytes a connection has read
+    // into a DataBuffer (e.g. with ReadFromFd), without copying them. The header of each frame
+    // is parsed once: when only part of the body has arrived the parsed header is kept, and the
+    // next call just compares the buffered size with the frame size, so no byte is scanned twice.
+    // Headers are checked before any of the body is waited for: body_length against
+    // max_body_length and, given find_limits (the generated FindWireSizeLimits), message_type
+    // and body_length against that type's WireSizeLimits.
+    // byte_order is the schema byte order; the generated <File>MessageFramer passes kByteOrder
+    // and its FindWireSizeLimits.
+    template <DataBuffer::ByteOrder byte_order>
+    class MessageFramer
+    {
+    public:
+        using LimitsFinder = const WireSizeLimits* (*)(MsgType_Def msg_type);
+
+        explicit MessageFramer(DataBuffer& buffer, bool host_to_network_byte_order = true,
+            uint32_t max_body_length = kDefaultMaxBodyLength, LimitsFinder find_limits = nullptr) noexcept
+            : buffer_(buffer)
+            , find_limits_(find_limits)
+            , max_body_length_(max_body_length)
+            , host_to_network_byte_order_(host_to_network_byte_order)
+        {
+        }
+
+        MessageFramer(const MessageFramer&) = delete;
+
+        MessageFramer& operator=(const MessageFramer&) = delete;
+
+        // returns the next complete frame and consumes it from the buffer
+        FrameStatus Next(Frame& frame) noexcept
+        {
+            if (!has_header_)
+            {
+                if (buffer_.Size() < FrameHeader::kSize)
+                {
+                    return FrameStatus::kNeedMore;
+                }
+
+                header_ = FrameHeader::Load<byte_order>(buffer_.Data(), host_to_network_byte_order_);
+                FrameStatus status = Check(header_);
+                if (status != FrameStatus::kFrame)
+                {
+                    return status;
+                }
+
+                has_header_ = true;
+            }
+
+            if (buffer_.Size() < header_.FrameSize())
+            {
+                return FrameStatus::kNeedMore;
+            }
+
+            frame.header = header_;
+            frame.data = buffer_.Data();
+            buffer_.Consume(header_.FrameSize());
+            has_header_ = false;
+            return FrameStatus::kFrame;
+        }
+
+        // bytes still missing from the pending frame; a lower bound while its header is incomplete
+        size_t MissingBytes() const noexcept
+        {
+            size_t need = has_header_ ? header_.FrameSize() : FrameHeader::kSize;
+            return buffer_.Size() < need ? need - buffer_.Size() : 0;
+        }
+
+        // forgets the pending header, call after discarding the buffered bytes
+        void Reset() noexcept
+        {
+            has_header_ = false;
+        }
+
+    private:
+        FrameStatus Check(const FrameHeader& header) const noexcept
+        {
+            if (header.body_length > max_body_length_)
+            {
+                return FrameStatus::kOversized;
+            }
+
+            if (find_limits_ != nullptr)
+            {
+                const WireSizeLimits* limits = find_limits_(header.message_type);
+                if (limits == nullptr || header.body_length < limits->min_wire_size)
+                {
+                    return FrameStatus::kInvalid;
+                }
+
+                if (header.body_length > limits->max_wire_size)
+                {
+                    return FrameStatus::kOversized;
+                }
+            }
+
+            return FrameStatus::kFrame;
+        }
+
+        DataBuffer& buffer_;
+        FrameHeader header_;
+        LimitsFinder find_limits_;
+        uint32_t max_body_length_;
+        bool host_to_network_byte_order_;
+        bool has_header_ = false;
+    };
+
+} // namespace mp
@@ -10,4 +10,15 @@ namespace mp
         kWriteError,
         kReadError
     };
+
+    static const uint32_t kUnboundedWireSize = UINT32_MAX;
+
+    //Ϣ볤ȷΧ,  Decode ֮ǰܾ֡, Լ GetMsgSize() Ԥ
+    struct WireSizeLimits
+    {
+        MsgType_Def msg_type;
+        uint32_t min_wire_size;     //STRING/Sequence Ϊʱĳ
+        uint32_t fixed_prefix_size; //һ STRING/Sequence ֮ǰĶ
+        uint32_t max_wire_size;     //kUnboundedWireSize ʾ
+    };
 }
\ No newline at end of file
@@ -0,0 +1,157 @@
+#pragma once
+#include <atomic>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace mp
+{
+    // MpmcQueue is Dmitry Vyukov's bounded multi-producer multi-consumer queue: every cell
+    // carries a sequence number, so push and pop each take one CAS on their own index and
+    // never block. capacity must be a power of two.
+    template <typename T>
+    class MpmcQueue
+    {
+    public:
+        explicit MpmcQueue(size_t capacity)
+            : cells_(new Cell[capacity])
+            , mask_(capacity - 1)
+        {
+            // the index of a cell is pos & mask_, which only wraps right for a power of two
+            assert(capacity > 0 && (capacity & (capacity - 1)) == 0);
+            for (size_t i = 0; i < capacity; ++i)
+            {
+                cells_[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        MpmcQueue(const MpmcQueue&) = delete;
+
+        MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+        bool TryPush(const T& value) noexcept
+        {
+            size_t pos = enqueue_pos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = cells_[pos & mask_];
+                size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (enqueue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        cell.data = value;
+                        cell.sequence.store(pos + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // full
+                    return false;
+                }
+                else
+                {
+                    pos = enqueue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool TryPop(T& value) noexcept
+        {
+            size_t pos = dequeue_pos_.load(std::memory_order_relaxed);
+            for (;;)
+            {
+                Cell& cell = cells_[pos & mask_];
+                size_t sequence = cell.sequence.load(std::memory_order_acquire);
+                intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+                if (diff == 0)
+                {
+                    if (dequeue_pos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        value = cell.data;
+                        cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    // empty
+                    return false;
+                }
+                else
+                {
+                    pos = dequeue_pos_.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+    private:
+        struct Cell
+        {
+            std::atomic<size_t> sequence;
+            T data;
+        };
+
+        static const size_t kCacheLineSize = 64;
+
+        std::unique_ptr<Cell[]> cells_;
+        size_t mask_;
+        alignas(kCacheLineSize) std::atomic<size_t> enqueue_pos_{ 0 };
+        alignas(kCacheLineSize) std::atomic<size_t> dequeue_pos_{ 0 };
+    };
+
+    // ObjectPool keeps up to kCapacity released T objects for reuse, one pool per type.
+    // Release() resets the object with T::Clear() instead of destroying it, so its strings and
+    // vectors keep their capacity. Objects may be released on a different thread than the one
+    // that acquired them. When the pool is full, released objects are deleted.
+    template <typename T, size_t kCapacity = 1024>
+    class ObjectPool
+    {
+        static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0, "kCapacity must be a power of two");
+
+    public:
+        // never destroyed, so objects released during static destruction still have a pool
+        static ObjectPool& Instance()
+        {
+            static ObjectPool* instance = new ObjectPool();
+            return *instance;
+        }
+
+        T* Acquire()
+        {
+            T* object = nullptr;
+            if (free_.TryPop(object))
+            {
+                return object;
+            }
+
+            return new T();
+        }
+
+        void Release(T* object) noexcept
+        {
+            if (object == nullptr)
+            {
+                return;
+            }
+
+            object->Clear();
+            if (!free_.TryPush(object))
+            {
+                delete object;
+            }
+        }
+
+    private:
+        ObjectPool()
+            : free_(kCapacity)
+        {
+        }
+
+        MpmcQueue<T*> free_;
+    };
+
+} // namespace mp
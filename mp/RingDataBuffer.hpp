@@ -0,0 +1,453 @@
+#pragma once
+#include <assert.h>
+#include <cstdint>
+#include <string.h>
+#include "DataBuffer.hpp"
+#include "DataBufferView.hpp"
+#include <array>
+#include <new>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <stdlib.h>
+#include <unistd.h>
+#endif
+
+namespace mp
+{
+    // RingDataBuffer is a power-of-two ring whose storage is mapped twice, back to back,
+    // so the readable bytes and the writable space are always contiguous in memory.
+    // Consume() and Commit() only move indices; unlike DataBuffer there is no
+    // Adjustment() memmove. Bytes are copied only when the ring has to grow.
+    // Messages are decoded through View() (see DataBufferView), then Consume()d.
+    class RingDataBuffer
+    {
+    public:
+        using ByteOrder = DataBuffer::ByteOrder;
+
+        static const size_t kInitialSize = 64 * 1024;
+
+        // capacity is rounded up to a power of two and to the mapping granularity
+        explicit RingDataBuffer(size_t initial_size = kInitialSize)
+        {
+            Map(RoundUpCapacity(initial_size));
+        }
+
+        RingDataBuffer(const RingDataBuffer&) = delete;
+
+        RingDataBuffer& operator=(const RingDataBuffer&) = delete;
+
+        RingDataBuffer(RingDataBuffer&& other) noexcept
+        {
+            Swap(other);
+        }
+
+        RingDataBuffer& operator=(RingDataBuffer&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Unmap();
+                Swap(other);
+            }
+
+            return *this;
+        }
+
+        ~RingDataBuffer()
+        {
+            Unmap();
+        }
+
+        void Swap(RingDataBuffer& rhs) noexcept
+        {
+            std::swap(buffer_, rhs.buffer_);
+            std::swap(capacity_, rhs.capacity_);
+            std::swap(read_index_, rhs.read_index_);
+            std::swap(size_, rhs.size_);
+            std::swap(endian_, rhs.endian_);
+#if defined(_WIN32)
+            std::swap(mapping_, rhs.mapping_);
+#endif
+        }
+
+        // read ptr, followed by Size() contiguous bytes
+        char* Data() noexcept
+        {
+            return buffer_ + read_index_;
+        }
+
+        const char* Data() const noexcept
+        {
+            return buffer_ + read_index_;
+        }
+
+        // readable size
+        size_t Size() const noexcept
+        {
+            return size_;
+        }
+
+        // write ptr, followed by WritableBytes() contiguous bytes
+        char* WritePtr() noexcept
+        {
+            return buffer_ + ((read_index_ + size_) & (capacity_ - 1));
+        }
+
+        const char* WritePtr() const noexcept
+        {
+            return buffer_ + ((read_index_ + size_) & (capacity_ - 1));
+        }
+
+        size_t WritableBytes() const noexcept
+        {
+            return capacity_ - size_;
+        }
+
+        size_t Capacity() const noexcept
+        {
+            return capacity_;
+        }
+
+        DataBufferView View() const noexcept
+        {
+            DataBufferView view(Data(), Size());
+            view.SetEndian(endian_);
+            return view;
+        }
+
+        void Reset() noexcept
+        {
+            read_index_ = 0;
+            size_ = 0;
+        }
+
+        void Reserve(size_t len)
+        {
+            EnsureWritableBytes(len);
+        }
+
+        void Commit(size_t n) noexcept
+        {
+            assert(n <= WritableBytes());
+            size_ += std::min(n, WritableBytes());
+        }
+
+        void Consume(std::size_t n) noexcept
+        {
+            if (n < size_)
+            {
+                read_index_ = (read_index_ + n) & (capacity_ - 1);
+                size_ -= n;
+            }
+            else
+            {
+                Reset();
+            }
+        }
+
+        std::string_view Prepare(std::size_t n)
+        {
+            EnsureWritableBytes(n);
+            return std::string_view(WritePtr(), n);
+        }
+
+        void SetEndian(ByteOrder byte_order) noexcept
+        {
+            endian_ = byte_order;
+        }
+
+        ByteOrder GetEndian() const noexcept
+        {
+            return endian_;
+        }
+
+        std::string ToString() const
+        {
+            return std::string(Data(), Size());
+        }
+
+    public:
+        // Write
+        void Write(const void* buf, size_t len)
+        {
+            EnsureWritableBytes(len);
+            memcpy(WritePtr(), buf, len);
+            size_ += len;
+        }
+
+        void Write(std::string_view sv)
+        {
+            Write(sv.data(), sv.size());
+        }
+
+        template <size_t N>
+        void Write(const std::array<char, N>& array)
+        {
+            Write(array.data(), N);
+        }
+
+        template <size_t N>
+        void Write(const char(&array)[N])
+        {
+            Write(array, N);
+        }
+
+        template <ByteOrder byte_order = ByteOrder::kRuntime, typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        void Write(T value)
+        {
+            if constexpr (byte_order == ByteOrder::kLittleEndian)
+            {
+                value = endian::htole(value);
+            }
+            else if constexpr (byte_order == ByteOrder::kBigEndian)
+            {
+                value = endian::htobe(value);
+            }
+            else if constexpr (byte_order == ByteOrder::kRuntime)
+            {
+                if (endian_ == ByteOrder::kBigEndian)
+                {
+                    value = endian::htobe(value);
+                }
+                else if (endian_ == ByteOrder::kLittleEndian)
+                {
+                    value = endian::htole(value);
+                }
+            }
+
+            Write(&value, sizeof(value));
+        }
+
+    public:
+        // Peek
+        bool Peek(void* buf, size_t len) const noexcept
+        {
+            return View().Peek(buf, len);
+        }
+
+        template <ByteOrder byte_order = ByteOrder::kRuntime, typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        bool Peek(T& value) const noexcept
+        {
+            return View().template Peek<byte_order>(value);
+        }
+
+    public:
+        // Read
+        // Fetch consumes n bytes and returns a pointer to them, or nullptr if fewer are readable.
+        // The pointer stays valid until the next write.
+        const char* Fetch(char* /*scratch*/, size_t n) noexcept
+        {
+            if (Size() < n)
+            {
+                return nullptr;
+            }
+
+            const char* p = Data();
+            Consume(n);
+            return p;
+        }
+
+        bool Read(void* buf, size_t len) noexcept
+        {
+            if (Peek(buf, len))
+            {
+                Consume(len);
+                return true;
+            }
+
+            return false;
+        }
+
+        template <size_t N>
+        bool Read(std::array<char, N>& array) noexcept
+        {
+            return Read(array.data(), N);
+        }
+
+        template <ByteOrder byte_order = ByteOrder::kRuntime, typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        bool Read(T& value) noexcept
+        {
+            if (Peek<byte_order>(value))
+            {
+                Consume(sizeof(value));
+                return true;
+            }
+
+            return false;
+        }
+
+    private:
+        void EnsureWritableBytes(size_t len)
+        {
+            if (WritableBytes() < len)
+            {
+                Grow(len);
+            }
+            assert(WritableBytes() >= len);
+        }
+
+        void Grow(size_t len)
+        {
+            RingDataBuffer other(Size() + len);
+            other.SetEndian(endian_);
+            memcpy(other.buffer_, Data(), Size());
+            other.size_ = Size();
+            Swap(other);
+        }
+
+        static size_t Granularity() noexcept
+        {
+#if defined(_WIN32)
+            SYSTEM_INFO info;
+            GetSystemInfo(&info);
+            return info.dwAllocationGranularity;
+#else
+            return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#endif
+        }
+
+        static size_t RoundUpCapacity(size_t size) noexcept
+        {
+            size_t capacity = Granularity();
+            while (capacity < size)
+            {
+                capacity <<= 1;
+            }
+            return capacity;
+        }
+
+#if defined(_WIN32)
+        void Map(size_t capacity)
+        {
+            HANDLE mapping = CreateFileMappingW(INVALID_HANDLE_VALUE, nullptr, PAGE_READWRITE,
+                static_cast<DWORD>(static_cast<uint64_t>(capacity) >> 32), static_cast<DWORD>(capacity), nullptr);
+            if (mapping == nullptr)
+            {
+                throw std::bad_alloc();
+            }
+
+            // the reserved range is released before the two views are mapped into it,
+            // so another thread may take it in between; retry with a fresh range
+            for (int attempt = 0; attempt < 16; ++attempt)
+            {
+                char* base = static_cast<char*>(VirtualAlloc(nullptr, capacity * 2, MEM_RESERVE, PAGE_NOACCESS));
+                if (base == nullptr)
+                {
+                    break;
+                }
+                VirtualFree(base, 0, MEM_RELEASE);
+
+                void* first = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity, base);
+                if (first == nullptr)
+                {
+                    continue;
+                }
+
+                void* second = MapViewOfFileEx(mapping, FILE_MAP_ALL_ACCESS, 0, 0, capacity, base + capacity);
+                if (second == nullptr)
+                {
+                    UnmapViewOfFile(first);
+                    continue;
+                }
+
+                buffer_ = base;
+                capacity_ = capacity;
+                mapping_ = mapping;
+                return;
+            }
+
+            CloseHandle(mapping);
+            throw std::bad_alloc();
+        }
+
+        void Unmap() noexcept
+        {
+            if (buffer_ != nullptr)
+            {
+                UnmapViewOfFile(buffer_ + capacity_);
+                UnmapViewOfFile(buffer_);
+                CloseHandle(mapping_);
+                buffer_ = nullptr;
+                mapping_ = nullptr;
+            }
+        }
+#else
+        void Map(size_t capacity)
+        {
+#if defined(__linux__)
+            int fd = memfd_create("mp_ring_buffer", 0);
+#else
+            char path[] = "/tmp/mp_ring_buffer_XXXXXX";
+            int fd = mkstemp(path);
+            if (fd != -1)
+            {
+                unlink(path);
+            }
+#endif
+            if (fd == -1)
+            {
+                throw std::bad_alloc();
+            }
+
+            if (ftruncate(fd, static_cast<off_t>(capacity)) != 0)
+            {
+                close(fd);
+                throw std::bad_alloc();
+            }
+
+            // reserve the whole range first, then map the same pages over both halves
+            void* base = mmap(nullptr, capacity * 2, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+            if (base == MAP_FAILED)
+            {
+                close(fd);
+                throw std::bad_alloc();
+            }
+
+            char* p = static_cast<char*>(base);
+            if (mmap(p, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED
+                || mmap(p + capacity, capacity, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED)
+            {
+                munmap(base, capacity * 2);
+                close(fd);
+                throw std::bad_alloc();
+            }
+
+            // the mappings keep the pages alive
+            close(fd);
+            buffer_ = p;
+            capacity_ = capacity;
+        }
+
+        void Unmap() noexcept
+        {
+            if (buffer_ != nullptr)
+            {
+                munmap(buffer_, capacity_ * 2);
+                buffer_ = nullptr;
+            }
+        }
+#endif
+
+    private:
+        char* buffer_ = nullptr;
+        size_t capacity_ = 0;
+        size_t read_index_ = 0;
+        size_t size_ = 0;
+        ByteOrder endian_ = ByteOrder::kNative;
+#if defined(_WIN32)
+        HANDLE mapping_ = nullptr;
+#endif
+    };
+
+} // namespace mp
@@ -0,0 +1,486 @@
+#pragma once
+#include <assert.h>
+#include <cstdint>
+#include <string.h>
+#include "BufferAllocator.h"
+#include "DataBuffer.hpp"
+#include <array>
+#include <deque>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <sys/uio.h>
+#endif
+
+namespace mp
+{
+#if defined(_WIN32)
+    struct IoVec
+    {
+        void* iov_base;
+        size_t iov_len;
+    };
+#else
+    using IoVec = struct iovec;
+#endif
+
+    // SegmentedDataBuffer keeps its bytes in a chain of fixed-size chunks.
+    // Growing never copies data already written: a full tail chunk is followed by a new one,
+    // and chunks drained by Consume() are kept for reuse.
+    class SegmentedDataBuffer
+    {
+    public:
+        using ByteOrder = DataBuffer::ByteOrder;
+
+        static const size_t kDefaultChunkSize = 4096;
+
+        explicit SegmentedDataBuffer(size_t chunk_size = kDefaultChunkSize, BufferAllocator* allocator = DefaultBufferAllocator())
+            : chunk_size_(chunk_size)
+            , allocator_(allocator)
+        {
+            assert(chunk_size_ > 0);
+        }
+
+        SegmentedDataBuffer(const SegmentedDataBuffer&) = delete;
+
+        SegmentedDataBuffer& operator=(const SegmentedDataBuffer&) = delete;
+
+        SegmentedDataBuffer(SegmentedDataBuffer&& other) noexcept
+            : chunks_(std::move(other.chunks_))
+            , free_chunks_(std::move(other.free_chunks_))
+            , chunk_size_(other.chunk_size_)
+            , chunk_capacity_(other.chunk_capacity_)
+            , size_(other.size_)
+            , endian_(other.endian_)
+            , allocator_(other.allocator_)
+        {
+            other.chunks_.clear();
+            other.free_chunks_.clear();
+            other.size_ = 0;
+            other.endian_ = ByteOrder::kNative;
+        }
+
+        SegmentedDataBuffer& operator=(SegmentedDataBuffer&& other) noexcept
+        {
+            if (this != &other)
+            {
+                Release();
+                chunks_ = std::move(other.chunks_);
+                free_chunks_ = std::move(other.free_chunks_);
+                chunk_size_ = other.chunk_size_;
+                chunk_capacity_ = other.chunk_capacity_;
+                size_ = other.size_;
+                endian_ = other.endian_;
+                allocator_ = other.allocator_;
+
+                other.chunks_.clear();
+                other.free_chunks_.clear();
+                other.size_ = 0;
+                other.endian_ = ByteOrder::kNative;
+            }
+
+            return *this;
+        }
+
+        ~SegmentedDataBuffer()
+        {
+            Release();
+        }
+
+        void Swap(SegmentedDataBuffer& rhs) noexcept
+        {
+            std::swap(chunks_, rhs.chunks_);
+            std::swap(free_chunks_, rhs.free_chunks_);
+            std::swap(chunk_size_, rhs.chunk_size_);
+            std::swap(chunk_capacity_, rhs.chunk_capacity_);
+            std::swap(size_, rhs.size_);
+            std::swap(endian_, rhs.endian_);
+            std::swap(allocator_, rhs.allocator_);
+        }
+
+        // readable size
+        size_t Size() const noexcept
+        {
+            return size_;
+        }
+
+        size_t ChunkSize() const noexcept
+        {
+            return chunk_size_;
+        }
+
+        size_t ChunkCount() const noexcept
+        {
+            return chunks_.size();
+        }
+
+        // Reset drops all readable bytes but keeps the chunks for future writes.
+        void Reset() noexcept
+        {
+            for (auto& chunk : chunks_)
+            {
+                free_chunks_.push_back(chunk.data);
+            }
+            chunks_.clear();
+            size_ = 0;
+        }
+
+        void SetEndian(ByteOrder byte_order) noexcept
+        {
+            endian_ = byte_order;
+        }
+
+        ByteOrder GetEndian() const noexcept
+        {
+            return endian_;
+        }
+
+        // Prepare returns the contiguous writable space of the tail chunk,
+        // appending a chunk first if the tail is full.
+        std::string_view Prepare()
+        {
+            if (chunks_.empty() || chunks_.back().WritableBytes(chunk_size_) == 0)
+            {
+                AppendChunk();
+            }
+
+            Chunk& tail = chunks_.back();
+            return std::string_view(tail.data + tail.write_index, tail.WritableBytes(chunk_size_));
+        }
+
+        void Commit(size_t n) noexcept
+        {
+            assert(!chunks_.empty());
+            assert(n <= chunks_.back().WritableBytes(chunk_size_));
+            chunks_.back().write_index += n;
+            size_ += n;
+        }
+
+        void Consume(size_t n) noexcept
+        {
+            if (n >= size_)
+            {
+                Reset();
+                return;
+            }
+
+            size_ -= n;
+            while (n > 0)
+            {
+                Chunk& head = chunks_.front();
+                size_t m = std::min(n, head.Size());
+                head.read_index += m;
+                n -= m;
+                if (head.Size() == 0 && head.write_index == chunk_size_)
+                {
+                    free_chunks_.push_back(head.data);
+                    chunks_.pop_front();
+                }
+            }
+        }
+
+        // GetIoVec fills iov with the readable chunks, in order, for writev().
+        // Returns the number of entries used, at most max_iov.
+        size_t GetIoVec(IoVec* iov, size_t max_iov) const noexcept
+        {
+            size_t n = 0;
+            for (auto it = chunks_.begin(); it != chunks_.end() && n < max_iov; ++it)
+            {
+                if (it->Size() == 0)
+                {
+                    continue;
+                }
+
+                iov[n].iov_base = it->data + it->read_index;
+                iov[n].iov_len = it->Size();
+                ++n;
+            }
+
+            return n;
+        }
+
+        std::vector<IoVec> GetIoVec() const
+        {
+            std::vector<IoVec> v_iov(chunks_.size());
+            v_iov.resize(GetIoVec(v_iov.data(), v_iov.size()));
+            return v_iov;
+        }
+
+    public:
+        // Write
+        void Write(const void* buf, size_t len)
+        {
+            const char* p = static_cast<const char*>(buf);
+            size_ += len;
+            while (len > 0)
+            {
+                if (chunks_.empty() || chunks_.back().WritableBytes(chunk_size_) == 0)
+                {
+                    AppendChunk();
+                }
+
+                Chunk& tail = chunks_.back();
+                size_t n = std::min(len, tail.WritableBytes(chunk_size_));
+                memcpy(tail.data + tail.write_index, p, n);
+                tail.write_index += n;
+                p += n;
+                len -= n;
+            }
+        }
+
+        void Write(std::string_view sv)
+        {
+            Write(sv.data(), sv.size());
+        }
+
+        template <size_t N>
+        void Write(const std::array<char, N>& array)
+        {
+            Write(array.data(), N);
+        }
+
+        template <size_t N>
+        void Write(const char(&array)[N])
+        {
+            Write(array, N);
+        }
+
+        template <ByteOrder endian = ByteOrder::kRuntime, typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        void Write(T value)
+        {
+            value = ToByteOrder<endian>(value);
+            Write(&value, sizeof(value));
+        }
+
+    public:
+        // Peek
+        bool Peek(void* buf, size_t len) const noexcept
+        {
+            if (size_ < len)
+            {
+                return false;
+            }
+
+            char* p = static_cast<char*>(buf);
+            for (auto it = chunks_.begin(); len > 0; ++it)
+            {
+                size_t n = std::min(len, it->Size());
+                memcpy(p, it->data + it->read_index, n);
+                p += n;
+                len -= n;
+            }
+
+            return true;
+        }
+
+        template <size_t N>
+        bool Peek(std::array<char, N>& array) const noexcept
+        {
+            return Peek(array.data(), N);
+        }
+
+        template <ByteOrder endian = ByteOrder::kRuntime, typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        bool Peek(T& value) const noexcept
+        {
+            if (!Peek(&value, sizeof(value)))
+            {
+                return false;
+            }
+
+            value = FromByteOrder<endian>(value);
+            return true;
+        }
+
+    public:
+        // Read
+        // Fetch consumes n bytes and returns a pointer to them, or nullptr if fewer are readable.
+        // Bytes that straddle a chunk boundary are copied into scratch, which must hold n bytes.
+        // The pointer stays valid until the next write.
+        const char* Fetch(char* scratch, size_t n) noexcept
+        {
+            if (size_ < n)
+            {
+                return nullptr;
+            }
+
+            const char* p = scratch;
+            if (n > 0 && chunks_.front().Size() >= n)
+            {
+                p = chunks_.front().data + chunks_.front().read_index;
+            }
+            else
+            {
+                Peek(scratch, n);
+            }
+
+            Consume(n);
+            return p;
+        }
+
+        bool Read(void* buf, size_t len) noexcept
+        {
+            if (Peek(buf, len))
+            {
+                Consume(len);
+                return true;
+            }
+
+            return false;
+        }
+
+        template <size_t N>
+        bool Read(std::array<char, N>& array) noexcept
+        {
+            return Read(array.data(), N);
+        }
+
+        template <size_t N>
+        bool Read(char(&array)[N]) noexcept
+        {
+            return Read(array, N);
+        }
+
+        template <ByteOrder endian = ByteOrder::kRuntime, typename T,
+            typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+        bool Read(T& value) noexcept
+        {
+            if (Peek<endian>(value))
+            {
+                Consume(sizeof(value));
+                return true;
+            }
+
+            return false;
+        }
+
+        std::string ToString() const
+        {
+            std::string str(size_, '\0');
+            Peek(str.data(), str.size());
+            return str;
+        }
+
+    private:
+        struct Chunk
+        {
+            char* data;
+            size_t read_index;
+            size_t write_index;
+
+            size_t Size() const noexcept
+            {
+                return write_index - read_index;
+            }
+
+            size_t WritableBytes(size_t chunk_size) const noexcept
+            {
+                return chunk_size - write_index;
+            }
+        };
+
+        void AppendChunk()
+        {
+            char* data = nullptr;
+            if (!free_chunks_.empty())
+            {
+                data = free_chunks_.back();
+                free_chunks_.pop_back();
+            }
+            else
+            {
+                // every chunk is requested with the same size, so the allocator hands back the same capacity
+                chunk_capacity_ = chunk_size_;
+                data = allocator_->Allocate(chunk_capacity_);
+            }
+
+            chunks_.push_back(Chunk{ data, 0, 0 });
+        }
+
+        void Release() noexcept
+        {
+            for (auto& chunk : chunks_)
+            {
+                FreeChunk(chunk.data);
+            }
+            for (auto data : free_chunks_)
+            {
+                FreeChunk(data);
+            }
+            chunks_.clear();
+            free_chunks_.clear();
+            size_ = 0;
+        }
+
+        void FreeChunk(char* data) noexcept
+        {
+            allocator_->Deallocate(data, chunk_capacity_);
+        }
+
+        template <ByteOrder byte_order, typename T>
+        T ToByteOrder(T value) const noexcept
+        {
+            if constexpr (byte_order == ByteOrder::kLittleEndian)
+            {
+                return endian::htole(value);
+            }
+            else if constexpr (byte_order == ByteOrder::kBigEndian)
+            {
+                return endian::htobe(value);
+            }
+            else if constexpr (byte_order == ByteOrder::kRuntime)
+            {
+                if (endian_ == ByteOrder::kBigEndian)
+                {
+                    return endian::htobe(value);
+                }
+                else if (endian_ == ByteOrder::kLittleEndian)
+                {
+                    return endian::htole(value);
+                }
+            }
+
+            return value;
+        }
+
+        template <ByteOrder byte_order, typename T>
+        T FromByteOrder(T value) const noexcept
+        {
+            if constexpr (byte_order == ByteOrder::kLittleEndian)
+            {
+                return endian::letoh(value);
+            }
+            else if constexpr (byte_order == ByteOrder::kBigEndian)
+            {
+                return endian::betoh(value);
+            }
+            else if constexpr (byte_order == ByteOrder::kRuntime)
+            {
+                if (endian_ == ByteOrder::kBigEndian)
+                {
+                    return endian::betoh(value);
+                }
+                else if (endian_ == ByteOrder::kLittleEndian)
+                {
+                    return endian::letoh(value);
+                }
+            }
+
+            return value;
+        }
+
+    private:
+        std::deque<Chunk> chunks_;
+        std::vector<char*> free_chunks_;
+        size_t chunk_size_;
+        size_t chunk_capacity_ = 0;
+        size_t size_ = 0;
+        ByteOrder endian_ = ByteOrder::kNative;
+        BufferAllocator* allocator_;
+    };
+
+} // namespace mp
@@ -0,0 +1,226 @@
+// BatchDecoder: one Decode takes every complete frame of a read into a message of its own type,
+// in any mix of types, with an error for each frame that cannot be decoded; instances are reused
+// across batches; and the per-message cost against decoding frame by frame through MessageBase.
+#include "BatchDecoder.h"
+#include "MessageFramer.h"
+#include "TestMessage.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using mp_test::kByteOrder;
+    using mp_test::AppendMessage;
+    using mp_test::CheckMessage;
+    using Quote = mp_test::TestMessage<2001>;
+    using Trade = mp_test::TestMessage<2002>;
+
+    const size_t kMessageCount = 512;
+
+    template <typename... Messages>
+    using Decoder = mp::BatchDecoder<kByteOrder, Messages...>;
+
+    // a frame with any header and body, for the frames a sender should not have produced
+    void AppendRawFrame(mp::DataBuffer& stream, mp::MsgType_Def msg_type, const std::string& body)
+    {
+        mp::FrameHeader header;
+        header.message_type = msg_type;
+        header.body_length = static_cast<uint32_t>(body.size());
+        char bytes[mp::FrameHeader::kSize];
+        header.Store<kByteOrder>(bytes);
+        stream.Write(bytes, sizeof(bytes));
+        stream.Write(body.data(), body.size());
+    }
+
+    // the body of message i, without its header
+    template <typename Message>
+    std::string Body(uint64_t i)
+    {
+        mp::DataBuffer frame;
+        AppendMessage<Message>(frame, i);
+        return std::string(frame.Data() + mp::FrameHeader::kSize, frame.Size() - mp::FrameHeader::kSize);
+    }
+
+    void TestHomogeneous(const mp::DataBuffer& stream)
+    {
+        Decoder<Quote> decoder(kMessageCount);
+
+        // all but the last 3 bytes: the trailing partial frame stays in the buffer
+        mp::DataBuffer in;
+        in.Write(stream.Data(), stream.Size() - 3);
+        size_t count = decoder.Decode(in);
+        MP_CHECK(count == kMessageCount - 1 && decoder.Count() == count);
+        MP_CHECK(in.Size() > 0 && in.Size() < mp::FrameHeader::kSize + Body<Quote>(kMessageCount - 1).size());
+        for (size_t i = 0; i < count; ++i)
+        {
+            MP_CHECK(decoder.Frame(i).error == mp::ErrorCode::kSuccess);
+            CheckMessage(*decoder.Get<Quote>(i), i);
+        }
+    }
+
+    // one read of every kind of frame: each decodes into its own type in one call, and the
+    // frames that cannot be decoded get an error without stopping the ones after them
+    void TestMixedStream()
+    {
+        mp::DataBuffer stream;
+        AppendMessage<Quote>(stream, 0);
+        AppendMessage<Trade>(stream, 1);
+        AppendMessage<Quote>(stream, 2);
+        AppendRawFrame(stream, 2099, "unknown type");
+        AppendMessage<Trade>(stream, 4);
+        AppendRawFrame(stream, 2001, Body<Quote>(5).substr(0, 10)); // body shorter than its fields
+        AppendRawFrame(stream, 2002, Body<Trade>(6) + "!"); // a byte more than the fields
+        AppendMessage<Quote>(stream, 7);
+        size_t whole = stream.Size();
+        AppendMessage<Trade>(stream, 8);
+        stream.ReverCommit(1); // the last frame is still incomplete
+        size_t partial = stream.Size() - whole;
+
+        Decoder<Quote, Trade> decoder(16);
+        size_t consumed = 0;
+        MP_CHECK(decoder.Decode(stream.Data(), stream.Size(), consumed) == 8);
+        MP_CHECK(consumed == whole);
+
+        const mp::ErrorCode ok = mp::ErrorCode::kSuccess;
+        const mp::ErrorCode error = mp::ErrorCode::kReadError;
+        const mp::ErrorCode expected[] = { ok, ok, ok, error, ok, error, error, ok };
+        for (size_t i = 0; i < 8; ++i)
+        {
+            MP_CHECK(decoder.Frame(i).error == expected[i]);
+        }
+
+        CheckMessage(*decoder.Get<Quote>(0), 0);
+        CheckMessage(*decoder.Get<Trade>(1), 1);
+        CheckMessage(*decoder.Get<Quote>(2), 2);
+        MP_CHECK(decoder.Frame(3).message == nullptr && decoder.Frame(3).header.message_type == 2099);
+        CheckMessage(*decoder.Get<Trade>(4), 4);
+        CheckMessage(*decoder.Get<Quote>(7), 7);
+        MP_CHECK(decoder.Get<Trade>(0) == nullptr && decoder.Get<Quote>(1) == nullptr);
+        MP_CHECK(decoder.Get<Quote>(3) == nullptr && decoder.Get<Trade>(3) == nullptr);
+
+        // max_count stops early, the next call goes on from there
+        Decoder<Quote, Trade> small(3);
+        MP_CHECK(small.Decode(stream) == 3);
+        MP_CHECK(small.Decode(stream) == 3);
+        MP_CHECK(small.Frame(0).message == nullptr);
+        CheckMessage(*small.Get<Trade>(1), 4);
+        MP_CHECK(small.Decode(stream) == 2);
+        CheckMessage(*small.Get<Quote>(1), 7);
+        MP_CHECK(small.Decode(stream) == 0 && stream.Size() == partial);
+    }
+
+    // instances are reused: the second batch decodes into the messages of the first
+    void TestReuse(const mp::DataBuffer& stream)
+    {
+        Decoder<Quote, Trade> decoder(kMessageCount);
+        size_t consumed = 0;
+        MP_CHECK(decoder.Decode(stream.Data(), stream.Size(), consumed) == kMessageCount);
+        std::vector<Quote*> first;
+        for (size_t i = 0; i < kMessageCount; ++i)
+        {
+            first.push_back(decoder.Get<Quote>(i));
+        }
+
+        MP_CHECK(decoder.Decode(stream.Data(), stream.Size(), consumed) == kMessageCount);
+        for (size_t i = 0; i < kMessageCount; ++i)
+        {
+            MP_CHECK(decoder.Get<Quote>(i) == first[i]);
+            CheckMessage(*first[i], i);
+        }
+    }
+
+    // what one 64 KiB read hands over: ~1800 small frames in the connection's DataBuffer, every
+    // fourth one a Trade. Each round refills the buffer, then either decodes it with one
+    // BatchDecoder::Decode or takes frame by frame through a MessageFramer with a virtual Decode
+    // each, the path BatchDecoder replaces.
+    void BenchBatchAgainstSingle()
+    {
+        mp::DataBuffer stream;
+        size_t message_count = 0;
+        while (stream.Size() < 64 * 1024 - 64)
+        {
+            if (message_count % 4 == 3)
+            {
+                AppendMessage<Trade>(stream, message_count++);
+            }
+            else
+            {
+                AppendMessage<Quote>(stream, message_count++);
+            }
+        }
+
+        Decoder<Quote, Trade> decoder(message_count);
+        std::vector<Quote> quotes(message_count);
+        std::vector<Trade> trades(message_count);
+        std::vector<mp::ErrorCode> errors(message_count);
+        std::vector<mp::MessageBase*> messages; // as a caller holding them through the base class
+        for (size_t i = 0; i < message_count; ++i)
+        {
+            messages.push_back(i % 4 == 3 ? static_cast<mp::MessageBase*>(&trades[i]) : &quotes[i]);
+        }
+        mp::DataBuffer in(stream.Size());
+
+        auto batch = [&] {
+            in.Reset();
+            in.Write(stream.Data(), stream.Size());
+            MP_CHECK(decoder.Decode(in) == message_count);
+        };
+
+        auto single = [&] {
+            in.Reset();
+            in.Write(stream.Data(), stream.Size());
+            mp::MessageFramer<kByteOrder> framer(in);
+            mp::Frame frame;
+            size_t i = 0;
+            while (framer.Next(frame) == mp::FrameStatus::kFrame)
+            {
+                mp::MessageBase* message = messages[i];
+                MP_CHECK(frame.header.message_type == message->GetMsgType());
+                mp::DataBufferView view(frame.Body(), frame.header.body_length);
+                mp::MessageViewDecoder decoder(view);
+                errors[i++] = message->Decode(decoder);
+            }
+            MP_CHECK(i == message_count);
+        };
+
+        // best of a few interleaved runs, to keep the noise of a shared machine out
+        const size_t rounds = 200;
+        double batch_ns = 1e30;
+        double single_ns = 1e30;
+        for (int run = 0; run < 7; ++run)
+        {
+            batch_ns = std::min(batch_ns, mp_test::NanosPer(rounds * message_count, [&] {
+                for (size_t r = 0; r < rounds; ++r)
+                {
+                    batch();
+                }
+            }));
+            single_ns = std::min(single_ns, mp_test::NanosPer(rounds * message_count, [&] {
+                for (size_t r = 0; r < rounds; ++r)
+                {
+                    single();
+                }
+            }));
+        }
+
+        std::printf("%zu frames of %zu bytes, ns per message: BatchDecoder %.1f, MessageFramer + virtual Decode %.1f\n",
+            message_count, stream.Size() / message_count, batch_ns, single_ns);
+    }
+}
+
+int main()
+{
+    mp::DataBuffer stream;
+    for (size_t i = 0; i < kMessageCount; ++i)
+    {
+        AppendMessage<Quote>(stream, i);
+    }
+
+    TestHomogeneous(stream);
+    TestMixedStream();
+    TestReuse(stream);
+    BenchBatchAgainstSingle();
+    std::printf("BatchDecoderTest passed\n");
+    return 0;
+}
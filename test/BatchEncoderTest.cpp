@@ -0,0 +1,174 @@
+// BatchEncoder: each FlushPolicy limit makes ShouldFlush() true on its own, FrameOffsets() point at
+// the frames' headers, and a FlushToFd cut short by a full socket keeps the rest queued in front
+// of later appends, drops the frames it wrote out and delivers every frame once and in order.
+#include "BatchEncoder.h"
+#include "MessageFramer.h"
+#include "TestMessage.h"
+#include <string>
+#include <vector>
+
+namespace
+{
+    using mp_test::kByteOrder;
+    using Quote = mp_test::TestMessage<2001>;
+    using Trade = mp_test::TestMessage<2002>;
+    using Encoder = mp::BatchEncoder<kByteOrder>;
+
+    // limits none of the tests reach; the encoder reserves max_bytes and max_messages up front
+    const mp::FlushPolicy kNever = { 1u << 20, 1u << 16, std::chrono::hours(1) };
+
+    void Append(Encoder& encoder, uint64_t i)
+    {
+        Quote quote;
+        mp_test::FillMessage(quote, i);
+        MP_CHECK(encoder.Append(quote) == mp::ErrorCode::kSuccess);
+    }
+
+    void TestShouldFlush()
+    {
+        Encoder::Clock::time_point now = Encoder::Clock::now();
+
+        mp::FlushPolicy by_bytes = kNever;
+        by_bytes.max_bytes = 200;
+        Encoder bytes(by_bytes);
+        MP_CHECK(!bytes.ShouldFlush(now) && bytes.Deadline() == Encoder::Clock::time_point::max());
+        while (bytes.Size() < by_bytes.max_bytes)
+        {
+            MP_CHECK(!bytes.ShouldFlush(now));
+            Append(bytes, bytes.MessageCount());
+        }
+        MP_CHECK(bytes.ShouldFlush(now));
+
+        mp::FlushPolicy by_messages = kNever;
+        by_messages.max_messages = 3;
+        Encoder messages(by_messages);
+        for (uint64_t i = 0; i < 3; ++i)
+        {
+            MP_CHECK(!messages.ShouldFlush(now));
+            Append(messages, i);
+        }
+        MP_CHECK(messages.ShouldFlush(now));
+
+        mp::FlushPolicy by_delay = kNever;
+        by_delay.max_delay = std::chrono::milliseconds(5);
+        Encoder delay(by_delay);
+        Append(delay, 0);
+        Encoder::Clock::time_point deadline = delay.Deadline();
+        MP_CHECK(deadline > now && deadline <= Encoder::Clock::now() + by_delay.max_delay);
+        MP_CHECK(!delay.ShouldFlush(deadline - std::chrono::microseconds(1)));
+        MP_CHECK(delay.ShouldFlush(deadline));
+
+        // Clear starts over: nothing to flush until the next append
+        delay.Clear();
+        MP_CHECK(!delay.ShouldFlush(deadline) && delay.Size() == 0 && delay.MessageCount() == 0);
+        MP_CHECK(delay.Deadline() == Encoder::Clock::time_point::max());
+    }
+
+    void TestFrameOffsets()
+    {
+        Encoder encoder(kNever);
+        Append(encoder, 0);
+        Quote quote;
+        Trade trade;
+        mp_test::FillMessage(quote, 1);
+        mp_test::FillMessage(trade, 2);
+        mp::MessageBase* messages[] = { &quote, &trade };
+        MP_CHECK(encoder.Append(messages, 2) == mp::ErrorCode::kSuccess);
+        Append(encoder, 3);
+
+        MP_CHECK(encoder.MessageCount() == 4 && encoder.FrameOffsets().size() == 4);
+        size_t offset = 0;
+        for (size_t i = 0; i < 4; ++i)
+        {
+            MP_CHECK(encoder.FrameOffsets()[i] == offset);
+            mp::FrameHeader header = mp::FrameHeader::Load<kByteOrder>(encoder.Data() + offset);
+            MP_CHECK(header.message_type == (i == 2 ? 2002u : 2001u));
+            offset += header.FrameSize();
+        }
+        MP_CHECK(offset == encoder.Size());
+    }
+
+#if !defined(_WIN32)
+    // reads what is in the socket and takes the complete frames, checking they are 0, 1, 2...
+    void Receive(int fd, mp::DataBuffer& in, uint64_t& next)
+    {
+        while (in.ReadFromFd(fd) > 0)
+        {
+        }
+
+        mp::MessageFramer<kByteOrder> framer(in);
+        mp::Frame frame;
+        while (framer.Next(frame) == mp::FrameStatus::kFrame)
+        {
+            Quote quote;
+            mp::DataBufferView view(frame.Body(), frame.header.body_length);
+            mp::MessageViewDecoder decoder(view);
+            MP_CHECK(quote.Decode(decoder) == mp::ErrorCode::kSuccess);
+            mp_test::CheckMessage(quote, next++);
+        }
+    }
+
+    void TestPartialFlush()
+    {
+        mp_test::SocketPair sp;
+        int send_buffer = 4096;
+        MP_CHECK(::setsockopt(sp.fds[0], SOL_SOCKET, SO_SNDBUF, &send_buffer, sizeof(send_buffer)) == 0);
+
+        Encoder encoder(kNever);
+        uint64_t appended = 0;
+        while (encoder.Size() < 512 * 1024)
+        {
+            Append(encoder, appended++);
+        }
+        size_t batch_count = encoder.MessageCount();
+        size_t batch_size = encoder.Size();
+
+        // the socket takes a part of the batch
+        ssize_t n = encoder.FlushToFd(sp.fds[0]);
+        MP_CHECK(n > 0 && encoder.Size() == batch_size - static_cast<size_t>(n));
+        size_t written = static_cast<size_t>(n);
+
+        // the frames written out are gone: the first one left is at most partly written, the
+        // second one not at all
+        const std::vector<size_t>& offsets = encoder.FrameOffsets();
+        MP_CHECK(encoder.MessageCount() < batch_count && encoder.MessageCount() == offsets.size());
+        MP_CHECK(offsets.front() <= written && offsets[1] > written);
+        MP_CHECK(offsets.back() < batch_size);
+        mp::FrameHeader second = mp::FrameHeader::Load<kByteOrder>(encoder.Data() + (offsets[1] - written));
+        MP_CHECK(second.message_type == 2001u && offsets[2] - offsets[1] == second.FrameSize());
+
+        // more appends go behind the unsent bytes; drain and flush until everything is through
+        mp::DataBuffer in;
+        uint64_t received = 0;
+        for (int round = 0; round < 4; ++round)
+        {
+            for (int i = 0; i < 100; ++i)
+            {
+                Append(encoder, appended++);
+            }
+            Receive(sp.fds[1], in, received);
+            encoder.FlushToFd(sp.fds[0]);
+        }
+
+        while (encoder.Size() > 0)
+        {
+            Receive(sp.fds[1], in, received);
+            encoder.FlushToFd(sp.fds[0]);
+        }
+        MP_CHECK(encoder.MessageCount() == 0 && encoder.FrameOffsets().empty());
+        Receive(sp.fds[1], in, received);
+        MP_CHECK(received == appended && in.Size() == 0);
+    }
+#endif
+}
+
+int main()
+{
+    TestShouldFlush();
+    TestFrameOffsets();
+#if !defined(_WIN32)
+    TestPartialFlush();
+#endif
+    std::printf("BatchEncoderTest passed\n");
+    return 0;
+}
@@ -0,0 +1,136 @@
+// ReadFromFd/WriteToFd over a non-blocking AF_UNIX socket pair: syscalls per MB against a
+// fixed-size Prepare/read/Commit loop, partial writes on a full socket, and EOF.
+#include "DataBuffer.hpp"
+#include "TestUtil.h"
+#include <unistd.h>
+#include <errno.h>
+#include <string>
+
+namespace
+{
+    const size_t kTotalSize = 1024 * 1024;
+    const size_t kRoundSize = 48 * 1024; // fits the default socket buffer
+    const size_t kNaiveReadSize = 4096;
+
+    std::string Pattern(size_t size)
+    {
+        std::string s(size, '\0');
+        for (size_t i = 0; i < size; ++i)
+        {
+            s[i] = static_cast<char>(i * 131 + 7);
+        }
+        return s;
+    }
+
+    // read syscalls until EAGAIN, the failing one included
+    template <typename ReadOnce>
+    size_t Drain(ReadOnce&& read_once)
+    {
+        size_t calls = 0;
+        for (;;)
+        {
+            ++calls;
+            if (read_once() <= 0)
+            {
+                MP_CHECK(errno == EAGAIN || errno == EWOULDBLOCK);
+                return calls;
+            }
+        }
+    }
+
+    void TestSyscallsPerMb()
+    {
+        std::string payload = Pattern(kRoundSize);
+
+        size_t naive_calls = 0;
+        {
+            mp_test::SocketPair sp;
+            mp::DataBuffer in;
+            for (size_t sent = 0; sent < kTotalSize; sent += kRoundSize)
+            {
+                MP_CHECK(::write(sp.fds[0], payload.data(), payload.size()) == static_cast<ssize_t>(payload.size()));
+                naive_calls += Drain([&] {
+                    in.Prepare(kNaiveReadSize);
+                    ssize_t n = ::read(sp.fds[1], in.WritePtr(), kNaiveReadSize);
+                    if (n > 0)
+                    {
+                        in.Commit(static_cast<size_t>(n));
+                    }
+                    return n;
+                });
+            }
+            MP_CHECK(in.Size() == (kTotalSize + kRoundSize - 1) / kRoundSize * kRoundSize);
+        }
+
+        size_t readv_calls = 0;
+        size_t received = 0;
+        {
+            mp_test::SocketPair sp;
+            mp::DataBuffer in;
+            for (size_t sent = 0; sent < kTotalSize; sent += kRoundSize)
+            {
+                MP_CHECK(::write(sp.fds[0], payload.data(), payload.size()) == static_cast<ssize_t>(payload.size()));
+                readv_calls += Drain([&] { return in.ReadFromFd(sp.fds[1]); });
+                MP_CHECK(in.Size() == kRoundSize);
+                MP_CHECK(memcmp(in.Data(), payload.data(), kRoundSize) == 0);
+                // the buffer grew by what arrived, not by the 64 KiB spill area
+                MP_CHECK(in.Capacity() < 2 * kRoundSize);
+                received += in.Size();
+                in.Consume(in.Size());
+            }
+        }
+
+        std::printf("syscalls per MB: read(%zu) loop %zu, ReadFromFd %zu (received %zu bytes)\n",
+            kNaiveReadSize, naive_calls, readv_calls, received);
+        MP_CHECK(readv_calls * 4 < naive_calls);
+    }
+
+    void TestPartialWrites()
+    {
+        mp_test::SocketPair sp;
+        const size_t size = 4 * 1024 * 1024; // far more than the socket buffer
+        std::string payload = Pattern(size);
+
+        mp::DataBuffer out;
+        out.Write(payload.data(), payload.size());
+        mp::DataBuffer in;
+
+        ssize_t first = out.WriteToFd(sp.fds[0]);
+        MP_CHECK(first > 0 && static_cast<size_t>(first) < size);
+        MP_CHECK(out.Size() == size - static_cast<size_t>(first));
+
+        while (in.Size() < size)
+        {
+            int saved_errno = 0;
+            ssize_t n = in.ReadFromFd(sp.fds[1], &saved_errno);
+            MP_CHECK(n > 0 || saved_errno == EAGAIN || saved_errno == EWOULDBLOCK);
+            MP_CHECK(out.WriteToFd(sp.fds[0]) >= 0);
+        }
+
+        MP_CHECK(out.Size() == 0);
+        MP_CHECK(in.Size() == size);
+        MP_CHECK(memcmp(in.Data(), payload.data(), size) == 0);
+    }
+
+    void TestEof()
+    {
+        mp_test::SocketPair sp;
+        MP_CHECK(::write(sp.fds[0], "abc", 3) == 3);
+        ::close(sp.fds[0]);
+        sp.fds[0] = -1;
+
+        mp::DataBuffer in;
+        MP_CHECK(in.ReadFromFd(sp.fds[1]) == 3);
+        MP_CHECK(in.ReadFromFd(sp.fds[1]) == 0);
+        MP_CHECK(in.ToString() == "abc");
+    }
+}
+
+int main()
+{
+    TestSyscallsPerMb();
+    TestPartialWrites();
+    TestEof();
+    std::printf("DataBufferFdTest passed\n");
+    return 0;
+}
@@ -0,0 +1,142 @@
+// DataBufferView at the end of its bytes: integers decode in both byte orders and in the view's
+// runtime byte order, a read one byte past the end fails without consuming anything, ReadView and
+// Fetch point into the viewed memory, and a record cut short at any byte does not decode.
+#include "DataBufferView.hpp"
+#include "MessageDecoder.h"
+#include "MessageEncoder.h"
+#include "TestUtil.h"
+#include <string>
+
+namespace
+{
+    using ByteOrder = mp::DataBufferView::ByteOrder;
+
+    const char kBytes[] = { 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09 };
+
+    void TestIntegers()
+    {
+        mp::DataBufferView view(kBytes, sizeof(kBytes));
+        uint16_t u16 = 0;
+        MP_CHECK(view.Peek<ByteOrder::kBigEndian>(u16) && u16 == 0x0102);
+        MP_CHECK(view.Peek<ByteOrder::kLittleEndian>(u16) && u16 == 0x0201);
+        MP_CHECK(view.ConsumedBytes() == 0);
+
+        uint8_t u8 = 0;
+        MP_CHECK(view.Read<ByteOrder::kBigEndian>(u8) && u8 == 0x01);
+        uint64_t u64 = 0;
+        MP_CHECK(view.Read<ByteOrder::kBigEndian>(u64) && u64 == 0x0203040506070809);
+        MP_CHECK(view.Size() == 0 && view.ConsumedBytes() == sizeof(kBytes));
+
+        // kRuntime follows SetEndian
+        view.Rewind();
+        uint32_t u32 = 0;
+        view.SetEndian(ByteOrder::kBigEndian);
+        MP_CHECK(view.Peek(u32) && u32 == 0x01020304);
+        view.SetEndian(ByteOrder::kLittleEndian);
+        MP_CHECK(view.Peek(u32) && u32 == 0x04030201);
+        MP_CHECK((view.Peek<int16_t, ByteOrder::kBigEndian>() == int16_t(0x0102)));
+
+        int8_t i8 = 0;
+        const char negative[] = { static_cast<char>(0xFF), static_cast<char>(0xFE) };
+        mp::DataBufferView signed_view(negative, sizeof(negative));
+        int16_t i16 = 0;
+        MP_CHECK(signed_view.Peek<ByteOrder::kBigEndian>(i16) && i16 == -2);
+        MP_CHECK(signed_view.Read<ByteOrder::kBigEndian>(i8) && i8 == -1);
+        MP_CHECK(signed_view.Read<ByteOrder::kBigEndian>(i8) && i8 == -2);
+    }
+
+    void TestEnd()
+    {
+        for (size_t skip = 0; skip <= sizeof(kBytes); ++skip)
+        {
+            mp::DataBufferView view(kBytes, sizeof(kBytes));
+            view.Consume(skip);
+            size_t left = sizeof(kBytes) - skip;
+
+            // one byte more than is left fails and consumes nothing
+            char bytes[sizeof(kBytes) + 1];
+            MP_CHECK(!view.Peek(bytes, left + 1) && !view.Read(bytes, left + 1));
+            std::string_view sv;
+            MP_CHECK(!view.ReadView(sv, left + 1));
+            MP_CHECK(view.Fetch(nullptr, left + 1) == nullptr);
+            uint64_t u64 = 0;
+            MP_CHECK(left >= sizeof(u64) || (!view.Read<ByteOrder::kBigEndian>(u64) && !view.Peek<uint64_t>()));
+            MP_CHECK(view.Size() == left && view.ConsumedBytes() == skip);
+
+            // exactly what is left succeeds, without copying
+            MP_CHECK(view.ReadView(sv, left) && sv.data() == kBytes + skip && sv.size() == left);
+            MP_CHECK(view.Size() == 0);
+            view.ReverConsume(left);
+            MP_CHECK(view.Fetch(nullptr, left) == kBytes + skip && view.Size() == 0);
+        }
+
+        // consuming past the end empties the view
+        mp::DataBufferView view(kBytes, sizeof(kBytes));
+        view.Consume(sizeof(kBytes) + 1);
+        MP_CHECK(view.Size() == 0);
+
+        mp::DataBufferView empty;
+        uint8_t u8 = 0;
+        MP_CHECK(empty.Size() == 0 && !empty.Read<ByteOrder::kBigEndian>(u8));
+    }
+
+    void TestBufferUntouched()
+    {
+        mp::DataBuffer buffer;
+        buffer.Write(kBytes, sizeof(kBytes));
+        mp::DataBufferView view(buffer);
+        uint64_t u64 = 0;
+        MP_CHECK(view.Read<ByteOrder::kBigEndian>(u64) && view.Size() == 1);
+        MP_CHECK(buffer.Size() == sizeof(kBytes) && view.ToStringView() == std::string_view(kBytes + 8, 1));
+    }
+
+    // a record as a generated message lays it out: two integers and a length-prefixed string
+    bool DecodeRecord(mp::DataBufferView& view)
+    {
+        mp::MessageViewDecoder decoder(view);
+        uint64_t order_id = 0;
+        int32_t delta = 0;
+        uint32_t size = 0;
+        if (decoder.Read(order_id) != mp::ErrorCode::kSuccess || decoder.Read(delta) != mp::ErrorCode::kSuccess
+            || decoder.Read(size) != mp::ErrorCode::kSuccess)
+        {
+            return false;
+        }
+        std::string symbol(size, '\0');
+        if (decoder.Read(symbol) != mp::ErrorCode::kSuccess)
+        {
+            return false;
+        }
+        MP_CHECK(order_id == 123456 && delta == -7 && symbol == "SYM42");
+        return true;
+    }
+
+    void TestTruncatedRecord()
+    {
+        mp::DataBuffer body;
+        mp::MessageEncoder encoder(body);
+        encoder.Write(uint64_t(123456));
+        encoder.Write(int32_t(-7));
+        encoder.Write(uint32_t(5));
+        encoder.Write(std::string("SYM42"));
+
+        for (size_t size = 0; size < body.Size(); ++size)
+        {
+            mp::DataBufferView view(body.Data(), size);
+            MP_CHECK(!DecodeRecord(view));
+        }
+
+        mp::DataBufferView view(body);
+        MP_CHECK(DecodeRecord(view) && view.Size() == 0);
+    }
+}
+
+int main()
+{
+    TestIntegers();
+    TestEnd();
+    TestBufferUntouched();
+    TestTruncatedRecord();
+    std::printf("DataBufferViewTest passed\n");
+    return 0;
+}
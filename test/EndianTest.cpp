@@ -0,0 +1,141 @@
+// endian::swap: constant evaluation, the same results as the byte-pair swap it replaced for
+// integers, enums and floats, and ns per value of both over arrays of 16, 32 and 64 bit integers.
+#include "EndianConversion.hpp"
+#include "TestUtil.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <utility>
+#include <vector>
+
+namespace
+{
+    static_assert(mp::endian::swap<uint16_t>(0x0102) == 0x0201, "swap must be constexpr");
+    static_assert(mp::endian::swap<uint32_t>(0x01020304u) == 0x04030201u, "swap must be constexpr");
+    static_assert(mp::endian::swap<uint64_t>(0x0102030405060708ull) == 0x0807060504030201ull, "swap must be constexpr");
+    static_assert(mp::endian::swap<int8_t>(-2) == -2, "one byte is left alone");
+    static_assert(mp::endian::htobe(mp::endian::betoh<uint32_t>(0x01020304u)) == 0x01020304u, "round trip");
+
+    enum class Side : uint16_t { kBuy = 0x0102 };
+    static_assert(mp::endian::swap(Side::kBuy) == static_cast<Side>(0x0201), "enums swap their underlying type");
+
+    // endian::swap before it was constexpr: a function-local static to check the host on
+    // every call, then the bytes swapped pair by pair
+    template<typename T>
+    T LegacySwap(T out)
+    {
+        static union autodetect {
+            int word;
+            char byte[sizeof(int)];
+            autodetect() : word(1) {}
+        } _;
+        (void)_;
+
+        char* ptr = reinterpret_cast<char*>(&out);
+        switch (sizeof(T))
+        {
+        case 2:
+            std::swap(ptr[0], ptr[1]);
+            break;
+        case 4:
+            std::swap(ptr[0], ptr[3]);
+            std::swap(ptr[1], ptr[2]);
+            break;
+        case 8:
+            std::swap(ptr[0], ptr[7]);
+            std::swap(ptr[1], ptr[6]);
+            std::swap(ptr[2], ptr[5]);
+            std::swap(ptr[3], ptr[4]);
+            break;
+        }
+        return out;
+    }
+
+    template<typename T>
+    std::vector<T> RandomValues(size_t count)
+    {
+        std::mt19937_64 rng(5);
+        std::vector<T> values(count);
+        for (T& value : values)
+        {
+            value = static_cast<T>(rng());
+        }
+        return values;
+    }
+
+    template<typename T>
+    void TestAgainstLegacy()
+    {
+        for (T value : RandomValues<T>(10000))
+        {
+            MP_CHECK(mp::endian::swap(value) == LegacySwap(value));
+            MP_CHECK(mp::endian::swap(mp::endian::swap(value)) == value);
+        }
+    }
+
+    void TestFloat()
+    {
+        double value = 3.25;
+        double swapped = mp::endian::swap(value);
+        MP_CHECK(std::memcmp(&swapped, &value, sizeof(value)) != 0);
+        MP_CHECK(mp::endian::swap(swapped) == value);
+        uint64_t bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        uint64_t swapped_bits;
+        std::memcpy(&swapped_bits, &swapped, sizeof(swapped_bits));
+        MP_CHECK(swapped_bits == mp::endian::swap(bits));
+    }
+
+    // what a decoder does per field: load, swap, store
+    template<typename T>
+    void BenchSwap(const char* name)
+    {
+        const size_t count = 4096;
+        const size_t rounds = 2000;
+        std::vector<T> in = RandomValues<T>(count);
+        std::vector<T> out(count);
+
+        double legacy_ns = 1e30;
+        double swap_ns = 1e30;
+        for (int run = 0; run < 5; ++run)
+        {
+            legacy_ns = std::min(legacy_ns, mp_test::NanosPer(rounds * count, [&] {
+                for (size_t r = 0; r < rounds; ++r)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        out[i] = LegacySwap(in[i]);
+                    }
+                    in.swap(out);
+                }
+            }));
+            swap_ns = std::min(swap_ns, mp_test::NanosPer(rounds * count, [&] {
+                for (size_t r = 0; r < rounds; ++r)
+                {
+                    for (size_t i = 0; i < count; ++i)
+                    {
+                        out[i] = mp::endian::swap(in[i]);
+                    }
+                    in.swap(out);
+                }
+            }));
+        }
+        MP_CHECK(in == RandomValues<T>(count)); // an even number of swaps restores the input
+
+        std::printf("%s: ns per value, byte-pair swap %.3f, endian::swap %.3f\n", name, legacy_ns, swap_ns);
+    }
+}
+
+int main()
+{
+    TestAgainstLegacy<uint16_t>();
+    TestAgainstLegacy<int32_t>();
+    TestAgainstLegacy<uint64_t>();
+    TestFloat();
+    BenchSwap<uint16_t>("uint16_t");
+    BenchSwap<uint32_t>("uint32_t");
+    BenchSwap<uint64_t>("uint64_t");
+    std::printf("EndianTest passed\n");
+    return 0;
+}
@@ -0,0 +1,224 @@
+// Generated code for mp/message_definition.xml end to end: messages encoded with the generated
+// EncodeFrame, cut out of a stream fed in small chunks by the generated framer and dispatched to
+// a handler come out field for field, through the STRING, the Sequence of fixed-layout TestOrder
+// and the Sequence of arrays; frames with bytes left over or of unknown type are rejected; and
+// the generated BatchDecoder takes the same stream in one call.
+#include "MessageDispatcher.h"
+#include "TestUtil.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using namespace HAO::CODE;
+
+    AccountID_Def Account(uint64_t i)
+    {
+        AccountID_Def account;
+        std::string digits = std::to_string(1000000000 + i);
+        std::copy_n(digits.begin(), account.size(), account.begin());
+        return account;
+    }
+
+    BaseMessage MakeBase(uint64_t i)
+    {
+        BaseMessage message;
+        message.FillDefaultValue();
+        message.DeliverQty1 = static_cast<Qty_Def>(i) * 3;
+        message.MyID1 = Account(i);
+        message.UserInfo1 = "base " + std::to_string(i);
+        return message;
+    }
+
+    DeriveMessage MakeDerive(uint64_t i)
+    {
+        DeriveMessage message;
+        message.FillDefaultValue();
+        message.DeliverQty1 = -static_cast<Qty_Def>(i);
+        message.MyID1 = Account(i + 1);
+        message.UserInfo1 = std::string(i % 50, 'u'); // empty for some
+        message.DeliverQty = static_cast<Qty_Def>(i) << 40;
+        message.MyID = Account(i + 2);
+        for (uint64_t k = 0; k < i % 5; ++k)
+        {
+            TestOrder order;
+            order.FillDefaultValue();
+            order.DeliverQty = static_cast<Qty_Def>(k) - 2;
+            order.MyID = Account(k);
+            order.OrderID = i * 100 + k;
+            order.FundAccoutId = { 'F', 'U', 'N', 'D', static_cast<char>('0' + k) };
+            message.VOrder.push_back(order);
+        }
+        for (uint64_t k = 0; k < i % 3; ++k)
+        {
+            message.VAccountID.push_back(Account(i * 10 + k));
+        }
+        return message;
+    }
+
+    void CheckBase(const BaseMessage& actual, const BaseMessage& expected)
+    {
+        MP_CHECK(actual.DeliverQty1 == expected.DeliverQty1);
+        MP_CHECK(actual.MyID1 == expected.MyID1);
+        MP_CHECK(actual.UserInfo1 == expected.UserInfo1);
+    }
+
+    void CheckDerive(const DeriveMessage& actual, const DeriveMessage& expected)
+    {
+        CheckBase(actual, expected);
+        MP_CHECK(actual.DeliverQty == expected.DeliverQty);
+        MP_CHECK(actual.MyID == expected.MyID);
+        MP_CHECK(actual.VOrder.size() == expected.VOrder.size());
+        for (size_t k = 0; k < actual.VOrder.size(); ++k)
+        {
+            MP_CHECK(actual.VOrder[k].DeliverQty == expected.VOrder[k].DeliverQty);
+            MP_CHECK(actual.VOrder[k].MyID == expected.VOrder[k].MyID);
+            MP_CHECK(actual.VOrder[k].OrderID == expected.VOrder[k].OrderID);
+            MP_CHECK(actual.VOrder[k].FundAccoutId == expected.VOrder[k].FundAccoutId);
+        }
+        MP_CHECK(actual.VAccountID == expected.VAccountID);
+    }
+
+    struct Handler
+    {
+        std::vector<BaseMessage> bases;
+        std::vector<DeriveMessage> derives;
+
+        void On(const BaseMessage& message)
+        {
+            bases.push_back(message);
+        }
+
+        void On(const DeriveMessage& message)
+        {
+            derives.push_back(message);
+        }
+    };
+
+    const uint64_t kCount = 300;
+
+    // frame i is a DeriveMessage, every third one a BaseMessage
+    mp::DataBuffer MakeStream()
+    {
+        mp::DataBuffer stream;
+        for (uint64_t i = 0; i < kCount; ++i)
+        {
+            if (i % 3 == 0)
+            {
+                BaseMessage message = MakeBase(i);
+                MP_CHECK(message_definitionEncodeFrame(message, stream) == mp::ErrorCode::kSuccess);
+            }
+            else
+            {
+                DeriveMessage message = MakeDerive(i);
+                MP_CHECK(message_definitionEncodeFrame(message, stream) == mp::ErrorCode::kSuccess);
+            }
+        }
+        return stream;
+    }
+
+    void TestRoundTrip(const mp::DataBuffer& stream)
+    {
+        Handler handler;
+        message_definitionMessageDispatcher<Handler> dispatcher(handler);
+        mp::DataBuffer in;
+        message_definitionMessageFramer framer(in);
+        size_t pos = 0;
+        size_t frames = 0;
+        while (pos < stream.Size())
+        {
+            size_t chunk = std::min<size_t>(stream.Size() - pos, 1 + pos % 23);
+            in.Write(stream.Data() + pos, chunk);
+            pos += chunk;
+
+            mp::Frame frame;
+            mp::FrameStatus status;
+            while ((status = framer.Next(frame)) == mp::FrameStatus::kFrame)
+            {
+                MP_CHECK(dispatcher.Dispatch(frame.data, frame.Size()) == mp::ErrorCode::kSuccess);
+                ++frames;
+            }
+            MP_CHECK(status == mp::FrameStatus::kNeedMore);
+        }
+        MP_CHECK(frames == kCount);
+
+        MP_CHECK(handler.bases.size() == kCount / 3 && handler.derives.size() == kCount - kCount / 3);
+        size_t next_base = 0;
+        size_t next_derive = 0;
+        for (uint64_t i = 0; i < kCount; ++i)
+        {
+            if (i % 3 == 0)
+            {
+                CheckBase(handler.bases[next_base++], MakeBase(i));
+            }
+            else
+            {
+                CheckDerive(handler.derives[next_derive++], MakeDerive(i));
+            }
+        }
+    }
+
+    void TestRejected()
+    {
+        Handler handler;
+        message_definitionMessageDispatcher<Handler> dispatcher(handler);
+        DeriveMessage message = MakeDerive(7);
+
+        // a byte more in body_length than the message encodes
+        mp::DataBuffer frame;
+        MP_CHECK(message_definitionEncodeFrame(message, frame, message.GetMsgSize() + 1) == mp::ErrorCode::kWriteError);
+        mp::FrameHeader header;
+        header.message_type = kDeriveMessage;
+        header.body_length = message.GetMsgSize() + 1;
+        char bytes[mp::FrameHeader::kSize];
+        header.Store<kByteOrder>(bytes);
+        frame.Write(bytes, sizeof(bytes));
+        MP_CHECK(mp::EncodeTo(message, frame) == mp::ErrorCode::kSuccess);
+        frame.Write("!", 1);
+        MP_CHECK(dispatcher.Dispatch(frame.Data(), frame.Size()) == mp::ErrorCode::kReadError);
+
+        // the same frame one byte short
+        MP_CHECK(dispatcher.Dispatch(kDeriveMessage, frame.Data() + mp::FrameHeader::kSize, message.GetMsgSize() - 1)
+            == mp::ErrorCode::kReadError);
+        MP_CHECK(dispatcher.Dispatch(4242, frame.Data() + mp::FrameHeader::kSize, message.GetMsgSize())
+            == mp::ErrorCode::kReadError);
+        MP_CHECK(handler.derives.empty());
+
+        // and exactly right
+        MP_CHECK(dispatcher.Dispatch(kDeriveMessage, frame.Data() + mp::FrameHeader::kSize, message.GetMsgSize())
+            == mp::ErrorCode::kSuccess);
+        MP_CHECK(handler.derives.size() == 1);
+        CheckDerive(handler.derives[0], message);
+    }
+
+    void TestBatchDecoder(const mp::DataBuffer& stream)
+    {
+        message_definitionBatchDecoder decoder(kCount);
+        size_t consumed = 0;
+        MP_CHECK(decoder.Decode(stream.Data(), stream.Size(), consumed) == kCount && consumed == stream.Size());
+        for (uint64_t i = 0; i < kCount; ++i)
+        {
+            MP_CHECK(decoder.Frame(i).error == mp::ErrorCode::kSuccess);
+            if (i % 3 == 0)
+            {
+                CheckBase(*decoder.Get<BaseMessage>(i), MakeBase(i));
+                MP_CHECK(decoder.Get<DeriveMessage>(i) == nullptr);
+            }
+            else
+            {
+                CheckDerive(*decoder.Get<DeriveMessage>(i), MakeDerive(i));
+            }
+        }
+    }
+}
+
+int main()
+{
+    mp::DataBuffer stream = MakeStream();
+    TestRoundTrip(stream);
+    TestRejected();
+    TestBatchDecoder(stream);
+    std::printf("MessageDispatcherTest passed\n");
+    return 0;
+}
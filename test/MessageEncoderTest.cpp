@@ -0,0 +1,86 @@
+// EncodeFrame: the frame it writes is byte for byte FrameHeader + EncodeTo body, whether the header
+// goes into the prepend area of an empty buffer or is appended after earlier frames, including a
+// buffer without a prepend area whose read index has moved past kSize and which has to grow.
+#include "MessageEncoder.h"
+#include "TestMessage.h"
+#include <string>
+
+namespace
+{
+    using mp_test::kByteOrder;
+    using Quote = mp_test::TestMessage<2001>;
+
+    // the frame of message i, header written by hand
+    std::string ExpectedFrame(uint64_t i)
+    {
+        mp::DataBuffer expected;
+        mp_test::AppendMessage<Quote>(expected, i);
+        return std::string(expected.Data(), expected.Size());
+    }
+
+    std::string EncodeFrameOf(mp::DataBuffer& buffer, uint64_t i)
+    {
+        Quote quote;
+        mp_test::FillMessage(quote, i);
+        MP_CHECK(mp::EncodeFrame<kByteOrder>(quote, buffer) == mp::ErrorCode::kSuccess);
+        return std::string(buffer.Data(), buffer.Size());
+    }
+
+    void TestPrependArea()
+    {
+        mp::DataBuffer buffer;
+        char* body = buffer.WritePtr();
+        MP_CHECK(EncodeFrameOf(buffer, 1) == ExpectedFrame(1));
+        // the body was encoded in place and the header went in front of it
+        MP_CHECK(buffer.Data() + mp::FrameHeader::kSize == body);
+    }
+
+    void TestAppend()
+    {
+        mp::DataBuffer buffer;
+        std::string frames = EncodeFrameOf(buffer, 1);
+        MP_CHECK(EncodeFrameOf(buffer, 2) == frames + ExpectedFrame(2));
+    }
+
+    // no prepend area reserved: once the read index is past kSize the buffer looks as if it had
+    // one, but growing it for the body moves the read index back to 0
+    void TestNoReservedPrepend()
+    {
+        for (size_t initial_size : { 16, 64, 256 })
+        {
+            mp::DataBuffer buffer(initial_size, 0);
+            std::string filler(initial_size, 'x');
+            buffer.Write(filler.data(), filler.size());
+            buffer.Consume(filler.size());
+            MP_CHECK(buffer.Size() == 0 && buffer.PrependableBytes() >= mp::FrameHeader::kSize);
+            MP_CHECK(EncodeFrameOf(buffer, 3) == ExpectedFrame(3));
+        }
+
+        // fresh buffer, nothing in front of the write index
+        mp::DataBuffer buffer(256, 0);
+        MP_CHECK(EncodeFrameOf(buffer, 4) == ExpectedFrame(4));
+    }
+
+    void TestWrongSize()
+    {
+        Quote quote;
+        mp_test::FillMessage(quote, 5);
+        for (size_t filled : { 0, 1 })
+        {
+            mp::DataBuffer buffer;
+            std::string before = filled ? EncodeFrameOf(buffer, 6) : std::string();
+            MP_CHECK(mp::EncodeFrame<kByteOrder>(quote, buffer, quote.GetMsgSize() + 1) == mp::ErrorCode::kWriteError);
+            MP_CHECK(std::string(buffer.Data(), buffer.Size()) == before);
+        }
+    }
+}
+
+int main()
+{
+    TestPrependArea();
+    TestAppend();
+    TestNoReservedPrepend();
+    TestWrongSize();
+    std::printf("MessageEncoderTest passed\n");
+    return 0;
+}
@@ -0,0 +1,71 @@
+// The generated message table: CREATE_/ACQUIRE_ make the schema's messages by message number and
+// fall back to the messages registered at run time with REGIST_; pooled messages come back
+// Clear()ed; the runtime registry itself only knows the REGIST_ messages.
+#include "BaseMessage.h"
+#include "DeriveMessage.h"
+#include "MessageFactory.h"
+#include "TestMessage.h"
+#include <memory>
+
+using CustomMessage = mp_test::TestMessage<5000>;
+REGIST_MESSAGE_DEFINITION_MESSAGE(5000, CustomMessage);
+
+namespace
+{
+    using HAO::CODE::BaseMessage;
+    using HAO::CODE::DeriveMessage;
+    using HAO::CODE::message_definitionMessageFactory;
+    using HAO::CODE::message_definitionMessageTable;
+
+    void TestCreate()
+    {
+        // the macros end in their own ';', so they only go at the end of a statement
+        mp::MessageBase* created = CREATE_MESSAGE_DEFINITION_MESSAGE(1001)
+        std::unique_ptr<mp::MessageBase> base(created);
+        created = CREATE_MESSAGE_DEFINITION_MESSAGE(1002)
+        std::unique_ptr<mp::MessageBase> derive(created);
+        created = CREATE_MESSAGE_DEFINITION_MESSAGE(5000)
+        std::unique_ptr<mp::MessageBase> custom(created);
+        created = CREATE_MESSAGE_DEFINITION_MESSAGE(4242)
+        std::unique_ptr<mp::MessageBase> unknown(created);
+        MP_CHECK(dynamic_cast<BaseMessage*>(base.get()) && base->GetMsgType() == 1001);
+        MP_CHECK(dynamic_cast<DeriveMessage*>(derive.get()) && derive->GetMsgType() == 1002);
+        MP_CHECK(dynamic_cast<CustomMessage*>(custom.get()) && custom->GetMsgType() == 5000);
+        MP_CHECK(unknown == nullptr);
+
+        MP_CHECK(message_definitionMessageTable::Contains(1001) && message_definitionMessageTable::Contains(1002));
+        MP_CHECK(!message_definitionMessageTable::Contains(5000));
+
+        // generated messages are not in the runtime registry
+        std::unique_ptr<mp::MessageBase> registered(message_definitionMessageFactory::get().create(5000));
+        MP_CHECK(dynamic_cast<CustomMessage*>(registered.get()));
+        MP_CHECK(message_definitionMessageFactory::get().create(1001) == nullptr);
+    }
+
+    void TestAcquire()
+    {
+        mp::MessageBase* first = nullptr;
+        {
+            auto custom = ACQUIRE_MESSAGE_DEFINITION_MESSAGE(5000)
+            MP_CHECK(dynamic_cast<CustomMessage*>(custom.get()));
+            static_cast<CustomMessage*>(custom.get())->symbol = "dirty";
+            first = custom.get();
+        }
+        // the same object comes back from the pool, cleared
+        auto custom = ACQUIRE_MESSAGE_DEFINITION_MESSAGE(5000)
+        MP_CHECK(custom.get() == first && static_cast<CustomMessage*>(custom.get())->symbol.empty());
+
+        auto derive = ACQUIRE_MESSAGE_DEFINITION_MESSAGE(1002)
+        MP_CHECK(dynamic_cast<DeriveMessage*>(derive.get()));
+        auto unknown = ACQUIRE_MESSAGE_DEFINITION_MESSAGE(4242)
+        MP_CHECK(unknown == nullptr);
+    }
+}
+
+int main()
+{
+    TestCreate();
+    TestAcquire();
+    std::printf("MessageFactoryTest passed\n");
+    return 0;
+}
@@ -0,0 +1,155 @@
+// MessageFramer: a stream of frames fed in random-sized chunks (1 byte up to 4 KiB) must come out
+// whole and in order; headers failing max_body_length or the WireSizeLimits are rejected before
+// their body is buffered; and frames per second when the whole stream is already buffered.
+#include "MessageFramer.h"
+#include "TestUtil.h"
+#include <algorithm>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+    const mp::MsgType_Def kSmallType = 1001;
+    const mp::MsgType_Def kLargeType = 1002;
+    const size_t kFrameCount = 5000;
+
+    const mp::WireSizeLimits kLimits[] =
+    {
+        { kSmallType, 4, 4, 64 },
+        { kLargeType, 16, 16, mp::kUnboundedWireSize },
+    };
+
+    const mp::WireSizeLimits* FindLimits(mp::MsgType_Def msg_type)
+    {
+        switch (msg_type)
+        {
+        case kSmallType: return &kLimits[0];
+        case kLargeType: return &kLimits[1];
+        default: return nullptr;
+        }
+    }
+
+    using Framer = mp::MessageFramer<mp::DataBuffer::ByteOrder::kBigEndian>;
+
+    void AppendFrame(std::string& stream, mp::MsgType_Def msg_type, const std::string& body)
+    {
+        mp::FrameHeader header;
+        header.message_type = msg_type;
+        header.body_length = static_cast<uint32_t>(body.size());
+        char bytes[mp::FrameHeader::kSize];
+        header.Store<mp::DataBuffer::ByteOrder::kBigEndian>(bytes);
+        stream.append(bytes, sizeof(bytes));
+        stream.append(body);
+    }
+
+    // frame i carries its index in a body of 4 to 64 (small) or 16 to 2064 (large) bytes
+    std::string MakeStream(std::vector<std::string>& bodies)
+    {
+        std::mt19937 rng(7);
+        std::string stream;
+        for (size_t i = 0; i < kFrameCount; ++i)
+        {
+            bool small = i % 3 != 0;
+            size_t size = small ? 4 + rng() % 61 : 16 + rng() % 2049;
+            std::string body(size, static_cast<char>('a' + i % 26));
+            memcpy(&body[0], &i, 4);
+            AppendFrame(stream, small ? kSmallType : kLargeType, body);
+            bodies.push_back(body);
+        }
+        return stream;
+    }
+
+    void TestFragmentation(const std::string& stream, const std::vector<std::string>& bodies)
+    {
+        std::mt19937 rng(11);
+        for (size_t round = 0; round < 20; ++round)
+        {
+            // first rounds trickle 1, 2, 3... bytes at a time, the rest use random sizes up to 4 KiB
+            size_t max_chunk = round < 8 ? round + 1 : 4096;
+            mp::DataBuffer in;
+            Framer framer(in, true, mp::kDefaultMaxBodyLength, &FindLimits);
+            size_t next = 0;
+            size_t pos = 0;
+            while (pos < stream.size())
+            {
+                size_t chunk = std::min<size_t>(stream.size() - pos, 1 + rng() % max_chunk);
+                in.Write(stream.data() + pos, chunk);
+                pos += chunk;
+
+                mp::Frame frame;
+                mp::FrameStatus status;
+                while ((status = framer.Next(frame)) == mp::FrameStatus::kFrame)
+                {
+                    MP_CHECK(next < bodies.size());
+                    MP_CHECK(frame.header.message_type == (next % 3 != 0 ? kSmallType : kLargeType));
+                    MP_CHECK(std::string(frame.Body(), frame.header.body_length) == bodies[next]);
+                    ++next;
+                }
+                MP_CHECK(status == mp::FrameStatus::kNeedMore);
+                MP_CHECK(framer.MissingBytes() > 0 || in.Size() == 0);
+            }
+            MP_CHECK(next == kFrameCount);
+            MP_CHECK(in.Size() == 0);
+        }
+    }
+
+    mp::FrameStatus NextOfHeader(mp::MsgType_Def msg_type, uint32_t body_length, uint32_t max_body_length)
+    {
+        mp::FrameHeader header;
+        header.message_type = msg_type;
+        header.body_length = body_length;
+        char bytes[mp::FrameHeader::kSize];
+        header.Store<mp::DataBuffer::ByteOrder::kBigEndian>(bytes);
+        mp::DataBuffer in;
+        in.Write(bytes, sizeof(bytes));
+        Framer framer(in, true, max_body_length, &FindLimits);
+        mp::Frame frame;
+        return framer.Next(frame);
+    }
+
+    void TestHeaderChecks()
+    {
+        MP_CHECK(NextOfHeader(kLargeType, 1000, mp::kDefaultMaxBodyLength) == mp::FrameStatus::kNeedMore);
+        MP_CHECK(NextOfHeader(kLargeType, 0xFFFFFFF0u, mp::kDefaultMaxBodyLength) == mp::FrameStatus::kOversized);
+        MP_CHECK(NextOfHeader(kLargeType, 1000, 999) == mp::FrameStatus::kOversized);
+        MP_CHECK(NextOfHeader(kSmallType, 65, mp::kDefaultMaxBodyLength) == mp::FrameStatus::kOversized);
+        MP_CHECK(NextOfHeader(kSmallType, 3, mp::kDefaultMaxBodyLength) == mp::FrameStatus::kInvalid);
+        MP_CHECK(NextOfHeader(4242, 16, mp::kDefaultMaxBodyLength) == mp::FrameStatus::kInvalid);
+    }
+
+    void BenchThroughput(const std::string& stream)
+    {
+        const size_t rounds = 200;
+        mp::DataBuffer in(stream.size());
+        size_t frames = 0;
+        double ns = mp_test::NanosPer(rounds * kFrameCount, [&] {
+            for (size_t r = 0; r < rounds; ++r)
+            {
+                in.Reset();
+                in.Write(stream.data(), stream.size());
+                Framer framer(in, true, mp::kDefaultMaxBodyLength, &FindLimits);
+                mp::Frame frame;
+                while (framer.Next(frame) == mp::FrameStatus::kFrame)
+                {
+                    ++frames;
+                }
+            }
+        });
+        MP_CHECK(frames == rounds * kFrameCount);
+        std::printf("MessageFramer: %.1f ns per frame, %.1f Mframes/s (copy into the buffer included)\n",
+            ns, 1e3 / ns);
+    }
+}
+
+int main()
+{
+    std::vector<std::string> bodies;
+    std::string stream = MakeStream(bodies);
+    TestFragmentation(stream, bodies);
+    TestHeaderChecks();
+    BenchThroughput(stream);
+    std::printf("MessageFramerTest passed\n");
+    return 0;
+}
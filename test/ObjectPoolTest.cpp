@@ -0,0 +1,200 @@
+// MpmcQueue and ObjectPool: FIFO order and the full/empty ends of the queue, every value
+// delivered exactly once with several producers and consumers, objects acquired on one thread
+// and released on another come back cleared, and a full pool deletes what it cannot keep.
+#include "ObjectPool.h"
+#include "TestUtil.h"
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    // counts constructions and destructions; one type per test, since each type has one pool
+    template <int tag>
+    struct Tracked
+    {
+        static std::atomic<size_t> constructed;
+        static std::atomic<size_t> destroyed;
+
+        uint64_t value = 0;
+
+        Tracked()
+        {
+            ++constructed;
+        }
+
+        ~Tracked()
+        {
+            ++destroyed;
+        }
+
+        void Clear()
+        {
+            value = 0;
+        }
+    };
+
+    template <int tag>
+    std::atomic<size_t> Tracked<tag>::constructed{ 0 };
+
+    template <int tag>
+    std::atomic<size_t> Tracked<tag>::destroyed{ 0 };
+
+    void TestQueueEnds()
+    {
+        mp::MpmcQueue<int> queue(8);
+        int value = 0;
+        MP_CHECK(!queue.TryPop(value));
+        for (int round = 0; round < 3; ++round) // the indexes wrap around the cells
+        {
+            for (int i = 0; i < 8; ++i)
+            {
+                MP_CHECK(queue.TryPush(round * 8 + i));
+            }
+            MP_CHECK(!queue.TryPush(-1));
+            for (int i = 0; i < 8; ++i)
+            {
+                MP_CHECK(queue.TryPop(value) && value == round * 8 + i);
+            }
+            MP_CHECK(!queue.TryPop(value));
+        }
+    }
+
+    void TestQueueThreads()
+    {
+        const size_t kPerProducer = 200000;
+        const size_t kProducers = 2;
+        const size_t kConsumers = 2;
+        mp::MpmcQueue<size_t> queue(64);
+        std::vector<std::atomic<int>> seen(kPerProducer * kProducers);
+        std::atomic<size_t> popped{ 0 };
+
+        std::vector<std::thread> threads;
+        for (size_t p = 0; p < kProducers; ++p)
+        {
+            threads.emplace_back([&, p] {
+                for (size_t i = 0; i < kPerProducer; ++i)
+                {
+                    while (!queue.TryPush(p * kPerProducer + i))
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (size_t c = 0; c < kConsumers; ++c)
+        {
+            threads.emplace_back([&] {
+                size_t value = 0;
+                while (popped.load() < seen.size())
+                {
+                    if (queue.TryPop(value))
+                    {
+                        ++seen[value];
+                        ++popped;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (std::thread& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (std::atomic<int>& count : seen)
+        {
+            MP_CHECK(count.load() == 1);
+        }
+    }
+
+    // acquired on one thread, handed over through a queue, released on another
+    void TestPoolAcrossThreads()
+    {
+        using Object = Tracked<1>;
+        const uint64_t kCount = 200000;
+        const size_t kHandoff = 64;
+        mp::MpmcQueue<Object*> handoff(kHandoff);
+
+        std::thread producer([&] {
+            for (uint64_t i = 1; i <= kCount; ++i)
+            {
+                Object* object = mp::ObjectPool<Object>::Instance().Acquire();
+                MP_CHECK(object->value == 0); // released objects come back cleared
+                object->value = i;
+                while (!handoff.TryPush(object))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+        std::thread consumer([&] {
+            Object* object = nullptr;
+            for (uint64_t i = 1; i <= kCount; ++i)
+            {
+                while (!handoff.TryPop(object))
+                {
+                    std::this_thread::yield();
+                }
+                MP_CHECK(object->value == i);
+                mp::ObjectPool<Object>::Instance().Release(object);
+            }
+        });
+        producer.join();
+        consumer.join();
+
+        // at most one object per handoff cell plus one in each thread's hands was ever live,
+        // and the pool never filled up
+        MP_CHECK(Object::constructed.load() <= kHandoff + 2);
+        MP_CHECK(Object::destroyed.load() == 0);
+    }
+
+    void TestPoolFull()
+    {
+        using Object = Tracked<2>;
+        using Pool = mp::ObjectPool<Object, 4>;
+        std::vector<Object*> objects;
+        for (int i = 0; i < 10; ++i)
+        {
+            objects.push_back(Pool::Instance().Acquire());
+        }
+        MP_CHECK(Object::constructed.load() == 10);
+
+        // 4 go back to the pool, the other 6 are deleted, whichever thread releases them
+        std::thread releaser([&] {
+            for (Object* object : objects)
+            {
+                Pool::Instance().Release(object);
+            }
+        });
+        releaser.join();
+        MP_CHECK(Object::destroyed.load() == 6);
+
+        objects.clear();
+        for (int i = 0; i < 4; ++i)
+        {
+            objects.push_back(Pool::Instance().Acquire());
+        }
+        MP_CHECK(Object::constructed.load() == 10);
+        objects.push_back(Pool::Instance().Acquire());
+        MP_CHECK(Object::constructed.load() == 11);
+        for (Object* object : objects)
+        {
+            Pool::Instance().Release(object);
+        }
+        MP_CHECK(Object::destroyed.load() == 7);
+    }
+}
+
+int main()
+{
+    TestQueueEnds();
+    TestQueueThreads();
+    TestPoolAcrossThreads();
+    TestPoolFull();
+    std::printf("ObjectPoolTest passed\n");
+    return 0;
+}
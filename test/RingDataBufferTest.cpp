@@ -0,0 +1,175 @@
+// RingDataBuffer across the end of its storage: writes and reads that wrap around stay contiguous
+// through Data(), Prepare(), View() and Fetch(), integers split by the end decode in both byte
+// orders, and growing a wrapped ring keeps the bytes in order.
+#include "RingDataBuffer.hpp"
+#include "TestUtil.h"
+#include <algorithm>
+#include <cstring>
+#include <string>
+
+namespace
+{
+    using ByteOrder = mp::RingDataBuffer::ByteOrder;
+
+    std::string Pattern(size_t begin, size_t size)
+    {
+        std::string bytes(size, '\0');
+        for (size_t i = 0; i < size; ++i)
+        {
+            bytes[i] = static_cast<char>('a' + (begin + i) % 26);
+        }
+        return bytes;
+    }
+
+    // moves the write pointer to offset bytes before the end of the ring. One byte stays in
+    // front of it, since consuming everything rewinds the ring to the start; callers Consume(1)
+    // once they have written something after it.
+    void MoveToEnd(mp::RingDataBuffer& ring, size_t offset)
+    {
+        size_t capacity = ring.Capacity();
+        ring.Reset();
+        ring.Write(Pattern(0, capacity - offset));
+        ring.Consume(capacity - offset - 1);
+        MP_CHECK(ring.Size() == 1 && ring.WritePtr() == ring.Data() + 1);
+    }
+
+    void TestWrapAround()
+    {
+        mp::RingDataBuffer ring(1);
+        size_t capacity = ring.Capacity();
+        MP_CHECK(capacity > 0 && (capacity & (capacity - 1)) == 0);
+
+        // a window of bytes travels round the ring several times, in steps that do not divide it
+        const size_t kWindow = capacity / 3;
+        const size_t kStep = 1000;
+        size_t written = 0;
+        size_t read = 0;
+        ring.Write(Pattern(0, kWindow));
+        written = kWindow;
+        while (written < 5 * capacity)
+        {
+            ring.Write(Pattern(written, kStep));
+            written += kStep;
+            MP_CHECK(ring.Size() == written - read);
+            MP_CHECK(std::string(ring.Data(), ring.Size()) == Pattern(read, written - read));
+            ring.Consume(kStep);
+            read += kStep;
+        }
+        MP_CHECK(ring.Capacity() == capacity); // never grew
+
+        std::string bytes(ring.Size(), '\0');
+        MP_CHECK(ring.Read(&bytes[0], bytes.size()) && bytes == Pattern(read, written - read));
+    }
+
+    void TestIntegersAcrossEnd()
+    {
+        mp::RingDataBuffer ring(1);
+        for (size_t offset = 1; offset < 8; ++offset)
+        {
+            // the write pointer is offset bytes before the end, so the uint64 is split by it
+            MoveToEnd(ring, offset);
+            ring.Write<ByteOrder::kBigEndian>(uint64_t(0x0102030405060708));
+            ring.Write<ByteOrder::kLittleEndian>(uint32_t(0x0A0B0C0D));
+            ring.Consume(1);
+
+            uint64_t u64 = 0;
+            MP_CHECK(ring.Peek<ByteOrder::kLittleEndian>(u64) && u64 == 0x0807060504030201);
+            MP_CHECK(ring.Read<ByteOrder::kBigEndian>(u64) && u64 == 0x0102030405060708);
+            uint32_t u32 = 0;
+            MP_CHECK(ring.Read<ByteOrder::kLittleEndian>(u32) && u32 == 0x0A0B0C0D);
+            MP_CHECK(ring.Size() == 0 && !ring.Read<ByteOrder::kBigEndian>(u32));
+        }
+    }
+
+    void TestPrepareAcrossEnd()
+    {
+        mp::RingDataBuffer ring(1);
+        MoveToEnd(ring, 10);
+        ring.Write(Pattern(0, 5));
+        ring.Consume(1);
+
+        // the writable space after the 5 bytes runs past the end as one range
+        std::string_view space = ring.Prepare(100);
+        MP_CHECK(space.size() == 100 && space.data() == ring.Data() + 5);
+        std::string bytes = Pattern(5, 100);
+        std::memcpy(const_cast<char*>(space.data()), bytes.data(), bytes.size());
+        ring.Commit(bytes.size());
+
+        // a view and Fetch see one run of bytes
+        mp::DataBufferView view = ring.View();
+        std::string_view sv;
+        MP_CHECK(view.ReadView(sv, 105) && sv == Pattern(0, 105));
+        MP_CHECK(ring.Size() == 105); // the view does not consume the ring
+        const char* p = ring.Fetch(nullptr, 105);
+        MP_CHECK(p != nullptr && std::string(p, 105) == Pattern(0, 105) && ring.Size() == 0);
+    }
+
+    void TestGrowWrapped()
+    {
+        mp::RingDataBuffer ring(1);
+        size_t capacity = ring.Capacity();
+        MoveToEnd(ring, 100);
+        ring.Write(Pattern(0, capacity - 10)); // wraps
+        ring.Consume(1);
+        MP_CHECK(ring.WritableBytes() == 10);
+
+        ring.Write(Pattern(capacity - 10, 50)); // grows
+        MP_CHECK(ring.Capacity() > capacity && ring.Size() == capacity + 40);
+        MP_CHECK(std::string(ring.Data(), ring.Size()) == Pattern(0, capacity + 40));
+    }
+
+    // record i: a big-endian uint32 length, then i as a big-endian uint64 and i % 50 pattern bytes
+    void AppendRecord(mp::DataBuffer& stream, uint64_t i)
+    {
+        std::string text = Pattern(i, i % 50);
+        stream.Write<ByteOrder::kBigEndian>(static_cast<uint32_t>(sizeof(i) + text.size()));
+        stream.Write<ByteOrder::kBigEndian>(i);
+        stream.Write(text);
+    }
+
+    void TestRecordsAcrossEnd()
+    {
+        mp::RingDataBuffer ring(1);
+        size_t capacity = ring.Capacity();
+        mp::DataBuffer stream;
+        for (uint64_t i = 0; i < 5000; ++i)
+        {
+            AppendRecord(stream, i);
+        }
+
+        // feed the stream in pieces that do not line up with the records, read what is complete
+        size_t pos = 0;
+        uint64_t next = 0;
+        while (pos < stream.Size() || ring.Size() > 0)
+        {
+            size_t chunk = std::min<size_t>(stream.Size() - pos, 777);
+            ring.Write(stream.Data() + pos, chunk);
+            pos += chunk;
+
+            mp::DataBufferView view = ring.View();
+            uint32_t length = 0;
+            while (view.Peek<ByteOrder::kBigEndian>(length) && view.Size() >= sizeof(length) + length)
+            {
+                view.Consume(sizeof(length));
+                uint64_t i = 0;
+                std::string_view text;
+                MP_CHECK(view.Read<ByteOrder::kBigEndian>(i) && i == next);
+                MP_CHECK(view.ReadView(text, length - sizeof(i)) && text == Pattern(i, i % 50));
+                ++next;
+            }
+            ring.Consume(view.ConsumedBytes());
+        }
+        MP_CHECK(next == 5000 && ring.Capacity() == capacity);
+    }
+}
+
+int main()
+{
+    TestWrapAround();
+    TestIntegersAcrossEnd();
+    TestPrepareAcrossEnd();
+    TestGrowWrapped();
+    TestRecordsAcrossEnd();
+    std::printf("RingDataBufferTest passed\n");
+    return 0;
+}
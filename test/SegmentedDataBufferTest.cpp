@@ -0,0 +1,206 @@
+// SegmentedDataBuffer across chunk boundaries: integers written at every offset of a chunk read
+// back in both byte orders, Fetch copies only the bytes that straddle two chunks, GetIoVec lists
+// the readable bytes in order, drained chunks are reused, and fields encoded into chunks smaller
+// than themselves decode again.
+#include "MessageDecoder.h"
+#include "MessageEncoder.h"
+#include "SegmentedDataBuffer.hpp"
+#include "TestUtil.h"
+#include <algorithm>
+#include <string>
+#include <vector>
+
+namespace
+{
+    using ByteOrder = mp::SegmentedDataBuffer::ByteOrder;
+
+    const size_t kChunkSize = 16;
+
+    std::string Pattern(size_t size)
+    {
+        std::string bytes(size, '\0');
+        for (size_t i = 0; i < size; ++i)
+        {
+            bytes[i] = static_cast<char>('a' + i % 26);
+        }
+        return bytes;
+    }
+
+    std::string ReadAll(mp::SegmentedDataBuffer& buffer)
+    {
+        std::string bytes(buffer.Size(), '\0');
+        MP_CHECK(buffer.Read(&bytes[0], bytes.size()));
+        return bytes;
+    }
+
+    void TestIntegersAtEveryOffset()
+    {
+        for (size_t offset = 0; offset < kChunkSize; ++offset)
+        {
+            mp::SegmentedDataBuffer buffer(kChunkSize);
+            buffer.Write(Pattern(offset));
+            buffer.Write<ByteOrder::kBigEndian>(uint64_t(0x0102030405060708));
+            buffer.Write<ByteOrder::kLittleEndian>(uint32_t(0x0A0B0C0D));
+            buffer.Write<ByteOrder::kBigEndian>(int16_t(-2));
+            buffer.Write<ByteOrder::kLittleEndian>(uint64_t(0x1112131415161718));
+            MP_CHECK(buffer.Size() == offset + 22);
+            MP_CHECK(buffer.ChunkCount() == (offset + 22 + kChunkSize - 1) / kChunkSize);
+
+            std::string prefix(offset, '\0');
+            MP_CHECK(offset == 0 || buffer.Read(&prefix[0], offset));
+            MP_CHECK(prefix == Pattern(offset));
+
+            uint64_t u64 = 0;
+            MP_CHECK(buffer.Peek<ByteOrder::kBigEndian>(u64) && u64 == 0x0102030405060708);
+            MP_CHECK(buffer.Size() == 22); // Peek does not consume
+            MP_CHECK(buffer.Read<ByteOrder::kBigEndian>(u64) && u64 == 0x0102030405060708);
+            uint32_t u32 = 0;
+            MP_CHECK(buffer.Read<ByteOrder::kLittleEndian>(u32) && u32 == 0x0A0B0C0D);
+            int16_t i16 = 0;
+            MP_CHECK(buffer.Read<ByteOrder::kBigEndian>(i16) && i16 == -2);
+
+            // the same eight bytes seen in the other byte order
+            MP_CHECK(buffer.Peek<ByteOrder::kBigEndian>(u64) && u64 == 0x1817161514131211);
+            MP_CHECK(buffer.Read<ByteOrder::kLittleEndian>(u64) && u64 == 0x1112131415161718);
+
+            MP_CHECK(buffer.Size() == 0 && !buffer.Read<ByteOrder::kBigEndian>(u32));
+        }
+    }
+
+    void TestShortRead()
+    {
+        mp::SegmentedDataBuffer buffer(kChunkSize);
+        buffer.Write(Pattern(kChunkSize + 3));
+        char bytes[kChunkSize + 4];
+        MP_CHECK(!buffer.Peek(bytes, sizeof(bytes)) && !buffer.Read(bytes, sizeof(bytes)));
+        char scratch[kChunkSize + 4];
+        MP_CHECK(buffer.Fetch(scratch, sizeof(scratch)) == nullptr);
+        MP_CHECK(buffer.Size() == kChunkSize + 3); // nothing consumed
+        MP_CHECK(ReadAll(buffer) == Pattern(kChunkSize + 3));
+    }
+
+    void TestFetch()
+    {
+        mp::SegmentedDataBuffer buffer(kChunkSize);
+        std::string bytes = Pattern(3 * kChunkSize);
+        buffer.Write(bytes);
+        char scratch[kChunkSize] = {};
+
+        // inside the first chunk: a pointer into the chunk, scratch untouched
+        const char* p = buffer.Fetch(scratch, 10);
+        MP_CHECK(p != nullptr && p != scratch && std::string(p, 10) == bytes.substr(0, 10));
+
+        // bytes 10..18 straddle the first two chunks and are copied into scratch
+        p = buffer.Fetch(scratch, 8);
+        MP_CHECK(p == scratch && std::string(p, 8) == bytes.substr(10, 8));
+
+        // the first chunk is drained and released, the rest of the second is contiguous again
+        MP_CHECK(buffer.ChunkCount() == 2);
+        p = buffer.Fetch(scratch, kChunkSize - 2);
+        MP_CHECK(p != scratch && std::string(p, kChunkSize - 2) == bytes.substr(18, kChunkSize - 2));
+
+        // up to the very last byte of a chunk
+        MP_CHECK(buffer.Size() == kChunkSize && buffer.ChunkCount() == 1);
+        p = buffer.Fetch(scratch, kChunkSize);
+        MP_CHECK(p != scratch && std::string(p, kChunkSize) == bytes.substr(2 * kChunkSize));
+        MP_CHECK(buffer.Size() == 0);
+    }
+
+    void TestIoVec()
+    {
+        mp::SegmentedDataBuffer buffer(kChunkSize);
+        std::string bytes = Pattern(100);
+        for (size_t pos = 0; pos < bytes.size(); pos += 7)
+        {
+            buffer.Write(bytes.substr(pos, 7));
+        }
+        buffer.Consume(5);
+
+        std::vector<mp::IoVec> iov = buffer.GetIoVec();
+        MP_CHECK(iov.size() == 7);
+        MP_CHECK(iov.front().iov_len == kChunkSize - 5 && iov.back().iov_len == 100 % kChunkSize);
+        std::string gathered;
+        for (const mp::IoVec& v : iov)
+        {
+            gathered.append(static_cast<const char*>(v.iov_base), v.iov_len);
+        }
+        MP_CHECK(gathered == bytes.substr(5));
+
+        // a short iov array takes the leading chunks
+        mp::IoVec two[2];
+        MP_CHECK(buffer.GetIoVec(two, 2) == 2);
+        MP_CHECK(two[0].iov_base == iov[0].iov_base && two[1].iov_base == iov[1].iov_base);
+
+        // Prepare hands out the rest of the tail chunk, then a new chunk
+        std::string_view space = buffer.Prepare();
+        MP_CHECK(space.size() == kChunkSize - 100 % kChunkSize);
+        buffer.Commit(space.size());
+        space = buffer.Prepare();
+        MP_CHECK(space.size() == kChunkSize && buffer.ChunkCount() == 8);
+    }
+
+    void TestChunkReuse()
+    {
+        // writer and reader at different offsets of the chunk, a steady 40 bytes in between
+        mp::SegmentedDataBuffer buffer(kChunkSize);
+        std::string bytes = Pattern(1000);
+        buffer.Write(bytes.substr(0, 40));
+        size_t written = 40;
+        size_t read = 0;
+        size_t max_chunks = 0;
+        while (written + 11 <= bytes.size())
+        {
+            buffer.Write(bytes.substr(written, 11));
+            written += 11;
+            std::string part(11, '\0');
+            MP_CHECK(buffer.Read(&part[0], part.size()) && part == bytes.substr(read, 11));
+            read += 11;
+            max_chunks = std::max(max_chunks, buffer.ChunkCount());
+        }
+        MP_CHECK(buffer.Size() == 40 && max_chunks <= 40 / kChunkSize + 2);
+        MP_CHECK(ReadAll(buffer) == bytes.substr(read, 40));
+    }
+
+    void TestFieldsAcrossChunks()
+    {
+        // 7-byte chunks: every uint64 and most strings are split
+        mp::SegmentedDataBuffer buffer(7);
+        mp::SegmentedMessageEncoder encoder(buffer);
+        for (uint64_t i = 0; i < 50; ++i)
+        {
+            std::string symbol = "SYM" + std::to_string(i % 97);
+            MP_CHECK(encoder.Write(i) == mp::ErrorCode::kSuccess);
+            MP_CHECK(encoder.Write(static_cast<int64_t>(i) * 100 - 7) == mp::ErrorCode::kSuccess);
+            MP_CHECK(encoder.Write(static_cast<uint32_t>(symbol.size())) == mp::ErrorCode::kSuccess);
+            MP_CHECK(encoder.Write(symbol) == mp::ErrorCode::kSuccess);
+        }
+
+        mp::SegmentedMessageDecoder decoder(buffer);
+        for (uint64_t i = 0; i < 50; ++i)
+        {
+            uint64_t order_id = 0;
+            int64_t price = 0;
+            uint32_t size = 0;
+            MP_CHECK(decoder.Read(order_id) == mp::ErrorCode::kSuccess && order_id == i);
+            MP_CHECK(decoder.Read(price) == mp::ErrorCode::kSuccess && price == static_cast<int64_t>(i) * 100 - 7);
+            MP_CHECK(decoder.Read(size) == mp::ErrorCode::kSuccess);
+            std::string symbol(size, '\0');
+            MP_CHECK(decoder.Read(symbol) == mp::ErrorCode::kSuccess && symbol == "SYM" + std::to_string(i % 97));
+        }
+        MP_CHECK(buffer.Size() == 0);
+        uint64_t order_id = 0;
+        MP_CHECK(decoder.Read(order_id) == mp::ErrorCode::kReadError);
+    }
+}
+
+int main()
+{
+    TestIntegersAtEveryOffset();
+    TestShortRead();
+    TestFetch();
+    TestIoVec();
+    TestChunkReuse();
+    TestFieldsAcrossChunks();
+    std::printf("SegmentedDataBufferTest passed\n");
+    return 0;
+}
@@ -0,0 +1,145 @@
+#pragma once
+// A message written like a generated one, for the tests that need real frames without running
+// the generator: three integers and a STRING, big-endian.
+#include "FrameHeader.h"
+#include "MessageBase.h"
+#include "MessageDecoder.h"
+#include "MessageEncoder.h"
+#include "TestUtil.h"
+#include <string>
+
+namespace mp_test
+{
+    const mp::DataBuffer::ByteOrder kByteOrder = mp::DataBuffer::ByteOrder::kBigEndian;
+
+    template <mp::MsgType_Def msg_type>
+    class TestMessage final : public mp::MessageBase
+    {
+    public:
+        uint64_t order_id = 0;
+        int64_t price = 0;
+        uint32_t qty = 0;
+        std::string symbol;
+
+        void FillDefaultValue() override
+        {
+            Clear();
+        }
+
+        void Clear() override
+        {
+            order_id = 0;
+            price = 0;
+            qty = 0;
+            symbol.clear();
+        }
+
+        mp::MsgType_Def GetMsgType() override
+        {
+            return msg_type;
+        }
+
+        uint32_t GetMsgSize() override
+        {
+            return static_cast<uint32_t>(8 + 8 + 4 + 4 + symbol.size());
+        }
+
+        mp::ErrorCode Decode(mp::MessageDecoder& decoder) override
+        {
+            return DecodeImpl(decoder);
+        }
+
+        mp::ErrorCode Decode(mp::SegmentedMessageDecoder& decoder) override
+        {
+            return DecodeImpl(decoder);
+        }
+
+        mp::ErrorCode Decode(mp::MessageViewDecoder& decoder) override
+        {
+            return DecodeImpl(decoder);
+        }
+
+        mp::ErrorCode Encode(mp::MessageEncoder& encoder) override
+        {
+            return EncodeImpl(encoder);
+        }
+
+        mp::ErrorCode Encode(mp::SegmentedMessageEncoder& encoder) override
+        {
+            return EncodeImpl(encoder);
+        }
+
+        mp::ErrorCode Encode(mp::CursorMessageEncoder& encoder) override
+        {
+            return EncodeImpl(encoder);
+        }
+
+        void Dump(std::ostream& ostream) override
+        {
+            ostream << order_id << ' ' << price << ' ' << qty << ' ' << symbol;
+        }
+
+    private:
+        template <typename Decoder>
+        mp::ErrorCode DecodeImpl(Decoder& decoder)
+        {
+            uint32_t size = 0;
+            if (decoder.template Read<kByteOrder>(order_id) != mp::ErrorCode::kSuccess
+                || decoder.template Read<kByteOrder>(price) != mp::ErrorCode::kSuccess
+                || decoder.template Read<kByteOrder>(qty) != mp::ErrorCode::kSuccess
+                || decoder.template Read<kByteOrder>(size) != mp::ErrorCode::kSuccess)
+            {
+                return mp::ErrorCode::kReadError;
+            }
+            return decoder.ReadString(symbol, size);
+        }
+
+        template <typename Encoder>
+        mp::ErrorCode EncodeImpl(Encoder& encoder)
+        {
+            encoder.template Write<kByteOrder>(order_id);
+            encoder.template Write<kByteOrder>(price);
+            encoder.template Write<kByteOrder>(qty);
+            encoder.template Write<kByteOrder>(static_cast<uint32_t>(symbol.size()));
+            return encoder.Write(symbol.data(), static_cast<uint32_t>(symbol.size()));
+        }
+    };
+
+    using Quote = TestMessage<2001>;
+    using Trade = TestMessage<2002>;
+
+
+    // message i of a test stream: every field derived from i
+    template <typename Message>
+    void FillMessage(Message& message, uint64_t i)
+    {
+        message.order_id = i;
+        message.price = static_cast<int64_t>(i) * 100 - 7;
+        message.qty = static_cast<uint32_t>(i % 1000);
+        message.symbol = "SYM" + std::to_string(i % 97);
+    }
+
+    template <typename Message>
+    void CheckMessage(const Message& message, uint64_t i)
+    {
+        MP_CHECK(message.order_id == i);
+        MP_CHECK(message.price == static_cast<int64_t>(i) * 100 - 7);
+        MP_CHECK(message.qty == i % 1000);
+        MP_CHECK(message.symbol == "SYM" + std::to_string(i % 97));
+    }
+
+    // appends message i as FrameHeader + body, the header written by hand
+    template <typename Message>
+    void AppendMessage(mp::DataBuffer& stream, uint64_t i)
+    {
+        Message message;
+        FillMessage(message, i);
+        mp::FrameHeader header;
+        header.message_type = message.GetMsgType();
+        header.body_length = message.GetMsgSize();
+        char bytes[mp::FrameHeader::kSize];
+        header.Store<kByteOrder>(bytes);
+        stream.Write(bytes, sizeof(bytes));
+        MP_CHECK(mp::EncodeTo(message, stream) == mp::ErrorCode::kSuccess);
+    }
+}
@@ -0,0 +1,62 @@
+#pragma once
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+// MP_CHECK stays active in release builds, unlike assert
+#define MP_CHECK(cond)                                                              \
+    do                                                                              \
+    {                                                                               \
+        if (!(cond))                                                                \
+        {                                                                           \
+            std::fprintf(stderr, "%s:%d: check failed: %s\n", __FILE__, __LINE__, #cond); \
+            std::exit(1);                                                           \
+        }                                                                           \
+    } while (0)
+
+namespace mp_test
+{
+    // nanoseconds per iteration of f, run iterations times
+    template <typename F>
+    double NanosPer(size_t iterations, F&& f)
+    {
+        auto begin = std::chrono::steady_clock::now();
+        f();
+        auto end = std::chrono::steady_clock::now();
+        return std::chrono::duration<double, std::nano>(end - begin).count() / static_cast<double>(iterations);
+    }
+
+#if !defined(_WIN32)
+    // a connected, non-blocking AF_UNIX stream socket pair: write to fds[0], read from fds[1]
+    struct SocketPair
+    {
+        int fds[2] = { -1, -1 };
+
+        SocketPair()
+        {
+            MP_CHECK(::socketpair(AF_UNIX, SOCK_STREAM, 0, fds) == 0);
+            for (int fd : fds)
+            {
+                MP_CHECK(::fcntl(fd, F_SETFL, ::fcntl(fd, F_GETFL) | O_NONBLOCK) == 0);
+            }
+        }
+
+        ~SocketPair()
+        {
+            for (int fd : fds)
+            {
+                if (fd >= 0)
+                {
+                    ::close(fd);
+                }
+            }
+        }
+    };
+#endif
+}
@@ -0,0 +1,156 @@
+
+#include"MessageEncoder.h"
+#include"MessageDecoder.h"
+#include"ArrayUtil.h"
+
+#include"BaseMessage.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  ///<BaseMessage 1001 基础类
+  void BaseMessage::FillDefaultValue()
+  {
+      DeliverQty1 = 0; ///<交付数量
+      MyID1.fill(' '); ///<ID
+      //UserInfo1 = ""; ///<user
+  } ///<end BaseMessage FillDefaultValue
+
+  void BaseMessage::Clear()
+  {
+      DeliverQty1 = 0; ///<交付数量
+      MyID1.fill(' '); ///<ID
+      UserInfo1.clear(); ///<user
+  } ///<end BaseMessage Clear
+
+  uint32_t BaseMessage::GetMsgSize() 
+  {
+      uint32_t msg_size = 0;
+      msg_size += 8;///< sizeof(DeliverQty1)//交付数量
+      msg_size += 10;///<MyID1.size() ID
+      msg_size += 4 + static_cast<uint32_t>(UserInfo1.size());///<user
+      return msg_size;
+  }///<end BaseMessage GetMsgSize
+
+  ///<BaseMessage  BaseMessageView õıֶν, ֻ STRING (std::string / std::string_view)
+  template<typename Message, typename Decoder>
+  static mp::ErrorCode DecodeBaseMessageFields(Message& message, Decoder& decoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      {
+          char scratch[18]; ///<ֶ, ֻһγ
+          const char* p = decoder.Fetch(scratch, 18);
+          if (p == nullptr) return mp::ErrorCode::kReadError;
+          decoder.template Load<kByteOrder>(p + 0, message.DeliverQty1); ///<交付数量
+          decoder.template Load<kByteOrder>(p + 8, message.MyID1); ///<ID
+      }
+      uint32_t size_userinfo1 = 0; ///<UserInfo1С
+      ec = decoder.template Read<kByteOrder>(size_userinfo1);
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      ec = decoder.ReadString(message.UserInfo1, size_userinfo1); ///<user
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      return ec;
+  } ///<end of DecodeBaseMessageFields
+
+  template<typename Decoder>
+  mp::ErrorCode BaseMessage::DecodeImpl(Decoder& decoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      ec = DecodeBaseMessageFields(*this, decoder);
+      return ec;
+  } ///<end of BaseMessage DecodeImpl
+
+  mp::ErrorCode BaseMessage::Decode(mp::MessageDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of BaseMessage Decode
+
+  mp::ErrorCode BaseMessage::Decode(mp::SegmentedMessageDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of BaseMessage Decode
+
+  mp::ErrorCode BaseMessage::Decode(mp::MessageViewDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of BaseMessage Decode
+
+  mp::ErrorCode BaseMessageView::Decode(mp::MessageViewDecoder& decoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      ec = DecodeBaseMessageFields(*this, decoder);
+      return ec;
+  } ///<end of BaseMessageView Decode
+
+  bool BaseMessageAccessor::Measure(const char* data, size_t size, bool host_to_network_byte_order, size_t& wire_size)
+  {
+      if (size < kFixedPrefixSize) return false;
+      size_t offset = kFixedPrefixSize;
+      for (uint32_t i = kPrefixFieldCount; i < kFieldCount; ++i)
+      {
+          size_t field_size = 0;
+          if (!FieldWireSize(i, data + offset, size - offset, host_to_network_byte_order, field_size)) return false;
+          offset += field_size;
+      }
+      wire_size = offset;
+      return true;
+  } ///<end of BaseMessageAccessor Measure
+
+  bool BaseMessageAccessor::FieldWireSize(uint32_t index, const char* p, size_t remaining, bool host_to_network_byte_order, size_t& field_size)
+  {
+      uint32_t count = 0;
+      switch (index)
+      {
+      case 2: ///<UserInfo1 user
+          if (!LoadLength<kByteOrder>(p, remaining, host_to_network_byte_order, count)) return false;
+          field_size = 4 + static_cast<size_t>(count);
+          break;
+      default:
+          return false;
+      }
+      return field_size <= remaining;
+  } ///<end of BaseMessageAccessor FieldWireSize
+   
+  template<typename Encoder>
+  mp::ErrorCode BaseMessage::EncodeImpl(Encoder& encoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      ec = encoder.template Write<kByteOrder>(DeliverQty1); ///<交付数量
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      ec = encoder.Write(MyID1); ///<ID
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      ec = encoder.template Write<kByteOrder>(static_cast<uint32_t>(UserInfo1.size())); ///<user
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      ec = encoder.Write(UserInfo1.data(), UserInfo1.size());
+      return ec;
+  } ///<end of BaseMessage EncodeImpl
+
+  mp::ErrorCode BaseMessage::Encode(mp::MessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of BaseMessage Encode
+
+  mp::ErrorCode BaseMessage::Encode(mp::SegmentedMessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of BaseMessage Encode
+
+  mp::ErrorCode BaseMessage::Encode(mp::CursorMessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of BaseMessage Encode
+   
+  void BaseMessage::Dump(std::ostream& ostream) 
+  {
+      ostream << "[BaseMessage]" << "[1001]:";
+      ostream << "DeliverQty1:" << DeliverQty1; ///<交付数量
+      ostream << "|"; 
+      ostream << "MyID1:" <<mp::ToStringTrim(MyID1); ///<ID
+      ostream << "|"; 
+      ostream << "UserInfo1:" << UserInfo1; ///<user
+  } ///<end of BaseMessage Dump
+
+} ///<end of namespace HAO
+} ///<end of namespace CODE
@@ -0,0 +1,152 @@
+
+#pragma once
+
+#include<cstddef>
+#include<vector>
+#include<string_view>
+#include"TypesDefinition.h"
+#include"MessageTypesDefinition.h"
+#include"MessageAccessor.h"
+
+#include"MessageBase.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  /**
+  * @brief BaseMessage
+  *  1001 基础类
+  */
+  class BaseMessage: public mp::MessageBase 
+  {
+    public:
+      static constexpr uint32_t kMinWireSize = 22; ///<̱볤(), STRING/Sequence Ϊ
+      static constexpr uint32_t kFixedPrefixSize = 18; ///<һ STRING/Sequence ֮ǰĶ
+      BaseMessage() = default;
+      BaseMessage(const BaseMessage&) = default;
+      BaseMessage(BaseMessage&&) noexcept = default; ///<ƶ, ̼߳䴫
+      BaseMessage& operator=(const BaseMessage&) = default;
+      BaseMessage& operator=(BaseMessage&&) noexcept = default;
+      virtual void FillDefaultValue() override;
+      virtual void Clear() override;
+      virtual mp::MsgType_Def GetMsgType() override 
+      { 
+          ///<1001 基础类
+          return kBaseMessage;
+      }
+      virtual uint32_t GetMsgSize() override;
+      virtual mp::ErrorCode Decode(mp::MessageDecoder& decoder) override;
+      virtual mp::ErrorCode Decode(mp::SegmentedMessageDecoder& decoder) override;
+      virtual mp::ErrorCode Decode(mp::MessageViewDecoder& decoder) override;
+      virtual mp::ErrorCode Encode(mp::MessageEncoder& encoder) override;
+      virtual mp::ErrorCode Encode(mp::SegmentedMessageEncoder& encoder) override;
+      virtual mp::ErrorCode Encode(mp::CursorMessageEncoder& encoder) override;
+      virtual void Dump(std::ostream& ostream) override;
+    protected:
+      template<typename Decoder>
+      mp::ErrorCode DecodeImpl(Decoder& decoder);
+      template<typename Encoder>
+      mp::ErrorCode EncodeImpl(Encoder& encoder);
+    public:
+      Qty_Def DeliverQty1; ///<交付数量
+      AccountID_Def MyID1; ///<ID
+      UserInfo_Def UserInfo1; ///<user
+  }; ///< end of class BaseMessage
+
+  /**
+  * @brief BaseMessageView
+  *  ֻ BaseMessage: STRING ֶָѽֽڵ std::string_view,
+  *  ֻ mp::DataBufferView ԴڴڼЧ
+  */
+  class BaseMessageView
+  {
+    public:
+      mp::ErrorCode Decode(mp::MessageViewDecoder& decoder);
+    public:
+      Qty_Def DeliverQty1; ///<交付数量
+      AccountID_Def MyID1; ///<ID
+      std::string_view UserInfo1; ///<user
+  }; ///< end of class BaseMessageView
+
+  /**
+  * @brief BaseMessageAccessor
+  *  ֱֶӶȡѱ BaseMessage,  Decode. ֶ,  Accessor þ
+  *  ǰ׺ֶƫǳ; Խ STRING/Sequence ֶεһηʱһ鲢ƫ
+  */
+  class BaseMessageAccessor : public mp::MessageAccessor
+  {
+    public:
+      static const uint32_t kFieldCount = 3; ///<ֶ()
+      static const uint32_t kPrefixFieldCount = 2; ///<ǰ׺ֶ
+      static const uint32_t kFixedPrefixSize = BaseMessage::kFixedPrefixSize; ///<ǰ׺ֽ
+
+      BaseMessageAccessor(const char* data, size_t size, bool host_to_network_byte_order = true)
+          : mp::MessageAccessor(data, size, host_to_network_byte_order)
+      {
+          offsets_[0] = kFixedPrefixSize;
+      }
+
+      ///< Accessor, ǶϢ Get , ֵǰ Get  false
+      BaseMessageAccessor()
+          : BaseMessageAccessor(nullptr, 0)
+      {
+      }
+
+      ///<data һϢı볤, ݲ false
+      static bool Measure(const char* data, size_t size, bool host_to_network_byte_order, size_t& wire_size);
+
+      ///<Ϣ볤
+      bool GetWireSize(size_t& wire_size) const
+      {
+          return Resolve(kFieldCount, wire_size);
+      }
+    public:
+      bool GetDeliverQty1(Qty_Def& value) const ///<交付数量
+      {
+          if (size_ < 8) return false;
+          Load<kByteOrder>(data_ + 0, host_to_network_byte_order_, value);
+          return true;
+      }
+      bool GetMyID1(AccountID_Def& value) const ///<ID
+      {
+          if (size_ < 18) return false;
+          Load<kByteOrder>(data_ + 8, host_to_network_byte_order_, value);
+          return true;
+      }
+      bool GetUserInfo1(std::string_view& value) const ///<user
+      {
+          size_t offset = 0;
+          uint32_t length = 0;
+          if (!Resolve(2, offset) || !LoadLength<kByteOrder>(data_ + offset, size_ - offset, host_to_network_byte_order_, length)) return false;
+          if (size_ - offset - 4 < length) return false;
+          value = std::string_view(data_ + offset + 4, length);
+          return true;
+      }
+    private:
+      ///<ֶ index ƫ, index == kFieldCount ʱΪϢ볤
+      bool Resolve(uint32_t index, size_t& offset) const
+      {
+          if (size_ < kFixedPrefixSize) return false;
+          while (resolved_ <= index - kPrefixFieldCount)
+          {
+              size_t begin = offsets_[resolved_ - 1];
+              size_t field_size = 0;
+              if (!FieldWireSize(kPrefixFieldCount + resolved_ - 1, data_ + begin, size_ - begin, host_to_network_byte_order_, field_size)) return false;
+              offsets_[resolved_] = begin + field_size;
+              ++resolved_;
+          }
+          offset = offsets_[index - kPrefixFieldCount];
+          return true;
+      }
+
+      ///<ǰ׺֮ index ֶεı볤,  remaining  false
+      static bool FieldWireSize(uint32_t index, const char* p, size_t remaining, bool host_to_network_byte_order, size_t& field_size);
+
+      mutable size_t offsets_[kFieldCount - kPrefixFieldCount + 1]; ///<ǰ׺ֶ֮εƫƻ
+      mutable uint32_t resolved_ = 1; ///<offsets_ ֪ĸ
+  }; ///< end of class BaseMessageAccessor
+
+} ///< end of namespace HAO
+} ///< end of namespace CODE
@@ -0,0 +1,42 @@
+
+#pragma once
+
+#include "Constants.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  ///<CurrencyType  常量
+  bool CurrencyType::IsValid(const Currency_Def& value)
+  {
+      return (
+                value==kUSD ///<美国
+              ||value==kCNY ///<中国
+             );
+  }
+
+  ///<MyConstType  常量
+  bool MyConstType::IsValid(const int64_t& value)
+  {
+      return (
+                value==kall ///<全部
+              ||value==kall ///<全部
+             );
+  }
+
+  ///<MyMode  常量
+  bool MyMode::IsValid(const std::array<char,9>& value)
+  {
+      return (
+                value==kMode1 ///<模式1
+              ||value==kMode2 ///<模式2
+              ||value==kMode3 ///<模式3
+              ||value==kMode4 ///<模式4
+             );
+  }
+
+
+} ///<end of namespace HAO
+} ///<end of namespace CODE
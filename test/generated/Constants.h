@@ -0,0 +1,54 @@
+
+#pragma once
+#include"TypesDefinition.h"
+
+#include"ArrayUtil.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  /** 
+  * @brief CurrencyType 
+  *        常量
+  */
+  class CurrencyType  
+  {
+    public:
+      bool IsValid(const Currency_Def& value);
+      inline static Currency_Def kUSD = mp::ToArray<5>("USD"); //美国
+      inline static Currency_Def kCNY = mp::ToArray<5>("CNY"); //中国
+
+  }; ///<end of class CurrencyType 
+
+  /** 
+  * @brief MyConstType 
+  *        常量
+  */
+  class MyConstType  
+  {
+    public:
+      bool IsValid(const int64_t& value);
+      inline static int64_t kall = 10; ///<全部
+
+  }; ///<end of class MyConstType 
+
+  /** 
+  * @brief MyMode 
+  *        常量
+  */
+  class MyMode  
+  {
+    public:
+      bool IsValid(const std::array<char,9>& value);
+      inline static std::array<char,9> kMode1 = mp::ToArray<9>("MODE1"); //模式1
+      inline static std::array<char,9> kMode2 = mp::ToArray<9>("MODE2"); //模式2
+      inline static std::array<char,9> kMode3 = mp::ToArray<9>("MODE3"); //模式3
+      inline static std::array<char,9> kMode4 = mp::ToArray<9>("MODE4"); //模式4
+
+  }; ///<end of class MyMode 
+
+
+} ///<end of namespace HAO
+} ///<end of namespace CODE
@@ -0,0 +1,266 @@
+
+#include"MessageEncoder.h"
+#include"MessageDecoder.h"
+#include"ArrayUtil.h"
+
+#include"DeriveMessage.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  ///<DeriveMessage 1002 子类
+  void DeriveMessage::FillDefaultValue()
+  {
+      BaseMessage::FillDefaultValue();
+      DeliverQty = 0; ///<交付数量
+      MyID.fill(' '); ///<ID
+      //VOrder.clear(); ///<序列
+      //VAccountID.clear(); ///<序列
+  } ///<end DeriveMessage FillDefaultValue
+
+  void DeriveMessage::Clear()
+  {
+      BaseMessage::Clear();
+      DeliverQty = 0; ///<交付数量
+      MyID.fill(' '); ///<ID
+      VOrder.clear(); ///<序列
+      VAccountID.clear(); ///<序列
+  } ///<end DeriveMessage Clear
+
+  uint32_t DeriveMessage::GetMsgSize() 
+  {
+      uint32_t msg_size = 0;
+      msg_size += BaseMessage::GetMsgSize();
+      msg_size += 8;///< sizeof(DeliverQty)//交付数量
+      msg_size += 10;///<MyID.size() ID
+      ///<序列
+      msg_size += 4 ; 
+      for(auto& item : VOrder)
+      {
+          msg_size += item.GetMsgSize();
+      }
+      ///<序列
+      msg_size += 4 ; 
+      msg_size += static_cast<uint32_t>(VAccountID.size()) * 10; 
+      return msg_size;
+  }///<end DeriveMessage GetMsgSize
+
+  ///<DeriveMessage  DeriveMessageView õıֶν, ֻ STRING (std::string / std::string_view)
+  template<typename Message, typename Decoder>
+  static mp::ErrorCode DecodeDeriveMessageFields(Message& message, Decoder& decoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      {
+          char scratch[18]; ///<ֶ, ֻһγ
+          const char* p = decoder.Fetch(scratch, 18);
+          if (p == nullptr) return mp::ErrorCode::kReadError;
+          decoder.template Load<kByteOrder>(p + 0, message.DeliverQty); ///<交付数量
+          decoder.template Load<kByteOrder>(p + 8, message.MyID); ///<ID
+      }
+      uint32_t size_vorder = 0; ///<VOrderС
+      ec = decoder.template Read<kByteOrder>(size_vorder);
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      if (!decoder.CheckCount(size_vorder, TestOrder::kMinWireSize)) return mp::ErrorCode::kReadError;
+      message.VOrder.reserve(size_vorder);
+      for(uint32_t i=0; i<size_vorder; i++) ///<序列
+      {
+          if (i == message.VOrder.size()) message.VOrder.emplace_back();
+          ec=message.VOrder[i].Decode(decoder); ///<ϴνµԪ
+          if(ec!=mp::ErrorCode::kSuccess) return ec;
+      }
+      message.VOrder.resize(size_vorder);
+      uint32_t size_vaccountid = 0; ///<VAccountIDС
+      ec = decoder.template Read<kByteOrder>(size_vaccountid);
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      if (!decoder.CheckCount(size_vaccountid, 10)) return mp::ErrorCode::kReadError;
+      message.VAccountID.resize(size_vaccountid);
+      for(uint32_t i=0; i<size_vaccountid; i++) ///<序列
+      {
+          ec = decoder.Read(message.VAccountID[i]);
+          if (ec != mp::ErrorCode::kSuccess) return ec;
+      }
+      return ec;
+  } ///<end of DecodeDeriveMessageFields
+
+  template<typename Decoder>
+  mp::ErrorCode DeriveMessage::DecodeImpl(Decoder& decoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      ec = BaseMessage::Decode(decoder);
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      ec = DecodeDeriveMessageFields(*this, decoder);
+      return ec;
+  } ///<end of DeriveMessage DecodeImpl
+
+  mp::ErrorCode DeriveMessage::Decode(mp::MessageDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of DeriveMessage Decode
+
+  mp::ErrorCode DeriveMessage::Decode(mp::SegmentedMessageDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of DeriveMessage Decode
+
+  mp::ErrorCode DeriveMessage::Decode(mp::MessageViewDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of DeriveMessage Decode
+
+  mp::ErrorCode DeriveMessageView::Decode(mp::MessageViewDecoder& decoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      ec = BaseMessageView::Decode(decoder);
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      ec = DecodeDeriveMessageFields(*this, decoder);
+      return ec;
+  } ///<end of DeriveMessageView Decode
+
+  bool DeriveMessageAccessor::Measure(const char* data, size_t size, bool host_to_network_byte_order, size_t& wire_size)
+  {
+      if (size < kFixedPrefixSize) return false;
+      size_t offset = kFixedPrefixSize;
+      for (uint32_t i = kPrefixFieldCount; i < kFieldCount; ++i)
+      {
+          size_t field_size = 0;
+          if (!FieldWireSize(i, data + offset, size - offset, host_to_network_byte_order, field_size)) return false;
+          offset += field_size;
+      }
+      wire_size = offset;
+      return true;
+  } ///<end of DeriveMessageAccessor Measure
+
+  bool DeriveMessageAccessor::FieldWireSize(uint32_t index, const char* p, size_t remaining, bool host_to_network_byte_order, size_t& field_size)
+  {
+      uint32_t count = 0;
+      switch (index)
+      {
+      case 2: ///<UserInfo1 user
+          if (!LoadLength<kByteOrder>(p, remaining, host_to_network_byte_order, count)) return false;
+          field_size = 4 + static_cast<size_t>(count);
+          break;
+      case 3: ///<DeliverQty 交付数量
+          field_size = 8;
+          break;
+      case 4: ///<MyID ID
+          field_size = 10;
+          break;
+      case 5: ///<VOrder 序列
+          if (!LoadLength<kByteOrder>(p, remaining, host_to_network_byte_order, count)) return false;
+          field_size = 4;
+          for (uint32_t i = 0; i < count; ++i)
+          {
+              size_t item_size = 0;
+              if (!TestOrderAccessor::Measure(p + field_size, remaining - field_size, host_to_network_byte_order, item_size)) return false;
+              field_size += item_size;
+          }
+          break;
+      case 6: ///<VAccountID 序列
+          if (!LoadLength<kByteOrder>(p, remaining, host_to_network_byte_order, count)) return false;
+          field_size = 4 + static_cast<size_t>(count) * 10;
+          break;
+      default:
+          return false;
+      }
+      return field_size <= remaining;
+  } ///<end of DeriveMessageAccessor FieldWireSize
+
+  bool DeriveMessageAccessor::GetVOrder(uint32_t index, TestOrderAccessor& value) const
+  {
+      size_t offset = 0;
+      uint32_t count = 0;
+      if (!Resolve(5, offset) || !LoadLength<kByteOrder>(data_ + offset, size_ - offset, host_to_network_byte_order_, count)) return false;
+      if (index >= count) return false;
+      offset += 4;
+      for (uint32_t i = 0; i < index; ++i)
+      {
+          size_t item_size = 0;
+          if (!TestOrderAccessor::Measure(data_ + offset, size_ - offset, host_to_network_byte_order_, item_size)) return false;
+          offset += item_size;
+      }
+      value = TestOrderAccessor(data_ + offset, size_ - offset, host_to_network_byte_order_);
+      return true;
+  } ///<end of DeriveMessageAccessor GetVOrder
+
+  bool DeriveMessageAccessor::GetVAccountID(uint32_t index, AccountID_Def& value) const
+  {
+      size_t offset = 0;
+      uint32_t count = 0;
+      if (!Resolve(6, offset) || !LoadLength<kByteOrder>(data_ + offset, size_ - offset, host_to_network_byte_order_, count)) return false;
+      if (index >= count) return false;
+      size_t item = offset + 4 + static_cast<size_t>(index) * 10;
+      if (item + 10 > size_) return false;
+      Load<kByteOrder>(data_ + item, host_to_network_byte_order_, value);
+      return true;
+  } ///<end of DeriveMessageAccessor GetVAccountID
+   
+  template<typename Encoder>
+  mp::ErrorCode DeriveMessage::EncodeImpl(Encoder& encoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      ec = BaseMessage::Encode(encoder);
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      ec = encoder.template Write<kByteOrder>(DeliverQty); ///<交付数量
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      ec = encoder.Write(MyID); ///<ID
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      ec = encoder.template Write<kByteOrder>(static_cast<uint32_t>(VOrder.size())); ///<序列
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      for(auto& item : VOrder)
+      {
+          ec = item.Encode(encoder);
+          if (ec != mp::ErrorCode::kSuccess) return ec;
+       }
+      ec = encoder.template Write<kByteOrder>(static_cast<uint32_t>(VAccountID.size())); ///<序列
+      if (ec != mp::ErrorCode::kSuccess) return ec;
+      for(auto&& item : VAccountID)
+      {
+          ec = encoder.Write(item);
+          if(ec!=mp::ErrorCode::kSuccess) return ec;
+      }
+      return ec;
+  } ///<end of DeriveMessage EncodeImpl
+
+  mp::ErrorCode DeriveMessage::Encode(mp::MessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of DeriveMessage Encode
+
+  mp::ErrorCode DeriveMessage::Encode(mp::SegmentedMessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of DeriveMessage Encode
+
+  mp::ErrorCode DeriveMessage::Encode(mp::CursorMessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of DeriveMessage Encode
+   
+  void DeriveMessage::Dump(std::ostream& ostream) 
+  {
+      ostream << "[DeriveMessage]" << "[1002]:";
+      BaseMessage::Dump(ostream);
+      ostream << "DeliverQty:" << DeliverQty; ///<交付数量
+      ostream << "|"; 
+      ostream << "MyID:" <<mp::ToStringTrim(MyID); ///<ID
+      ostream << "|"; 
+      ostream << "VOrder" << " size: " << VOrder.size() << "[" ;
+      for(auto&& item : VOrder) ///<序列
+      {
+          item.Dump(ostream);
+          ostream << ",";
+      }
+      ostream<<"]";
+      ostream << "|"; 
+      ostream << "VAccountID" << " size: " << VAccountID.size() << "[" ;
+      for(auto&& item : VAccountID) ///<序列
+      {
+          ostream << "VAccountID item:" << mp::ToStringTrim(item) << ","; 
+      }
+      ostream<<"]";
+  } ///<end of DeriveMessage Dump
+
+} ///<end of namespace HAO
+} ///<end of namespace CODE
@@ -0,0 +1,181 @@
+
+#pragma once
+
+#include<cstddef>
+#include<vector>
+#include<string_view>
+#include"TypesDefinition.h"
+#include"MessageTypesDefinition.h"
+#include"MessageAccessor.h"
+
+#include"BaseMessage.h"
+#include"TestOrder.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  /**
+  * @brief DeriveMessage
+  *  1002 子类
+  */
+  class DeriveMessage final: public BaseMessage 
+  {
+    public:
+      static constexpr uint32_t kMinWireSize = 48; ///<̱볤(), STRING/Sequence Ϊ
+      static constexpr uint32_t kFixedPrefixSize = 18; ///<һ STRING/Sequence ֮ǰĶ
+      DeriveMessage() = default;
+      DeriveMessage(const DeriveMessage&) = default;
+      DeriveMessage(DeriveMessage&&) noexcept = default; ///<ƶ, ̼߳䴫
+      DeriveMessage& operator=(const DeriveMessage&) = default;
+      DeriveMessage& operator=(DeriveMessage&&) noexcept = default;
+      virtual void FillDefaultValue() override;
+      virtual void Clear() override;
+      virtual mp::MsgType_Def GetMsgType() override 
+      { 
+          ///<1002 子类
+          return kDeriveMessage;
+      }
+      virtual uint32_t GetMsgSize() override;
+      virtual mp::ErrorCode Decode(mp::MessageDecoder& decoder) override;
+      virtual mp::ErrorCode Decode(mp::SegmentedMessageDecoder& decoder) override;
+      virtual mp::ErrorCode Decode(mp::MessageViewDecoder& decoder) override;
+      virtual mp::ErrorCode Encode(mp::MessageEncoder& encoder) override;
+      virtual mp::ErrorCode Encode(mp::SegmentedMessageEncoder& encoder) override;
+      virtual mp::ErrorCode Encode(mp::CursorMessageEncoder& encoder) override;
+      virtual void Dump(std::ostream& ostream) override;
+    protected:
+      template<typename Decoder>
+      mp::ErrorCode DecodeImpl(Decoder& decoder);
+      template<typename Encoder>
+      mp::ErrorCode EncodeImpl(Encoder& encoder);
+    public:
+      Qty_Def DeliverQty; ///<交付数量
+      AccountID_Def MyID; ///<ID
+      std::vector<TestOrder> VOrder; ///<序列
+      std::vector<AccountID_Def> VAccountID; ///<序列
+  }; ///< end of class DeriveMessage
+
+  /**
+  * @brief DeriveMessageView
+  *  ֻ DeriveMessage: STRING ֶָѽֽڵ std::string_view,
+  *  ֻ mp::DataBufferView ԴڴڼЧ
+  */
+  class DeriveMessageView : public BaseMessageView
+  {
+    public:
+      mp::ErrorCode Decode(mp::MessageViewDecoder& decoder);
+    public:
+      Qty_Def DeliverQty; ///<交付数量
+      AccountID_Def MyID; ///<ID
+      std::vector<TestOrderView> VOrder; ///<序列
+      std::vector<AccountID_Def> VAccountID; ///<序列
+  }; ///< end of class DeriveMessageView
+
+  /**
+  * @brief DeriveMessageAccessor
+  *  ֱֶӶȡѱ DeriveMessage,  Decode. ֶ,  Accessor þ
+  *  ǰ׺ֶƫǳ; Խ STRING/Sequence ֶεһηʱһ鲢ƫ
+  */
+  class DeriveMessageAccessor : public mp::MessageAccessor
+  {
+    public:
+      static const uint32_t kFieldCount = 7; ///<ֶ()
+      static const uint32_t kPrefixFieldCount = 2; ///<ǰ׺ֶ
+      static const uint32_t kFixedPrefixSize = DeriveMessage::kFixedPrefixSize; ///<ǰ׺ֽ
+
+      DeriveMessageAccessor(const char* data, size_t size, bool host_to_network_byte_order = true)
+          : mp::MessageAccessor(data, size, host_to_network_byte_order)
+      {
+          offsets_[0] = kFixedPrefixSize;
+      }
+
+      ///< Accessor, ǶϢ Get , ֵǰ Get  false
+      DeriveMessageAccessor()
+          : DeriveMessageAccessor(nullptr, 0)
+      {
+      }
+
+      ///<data һϢı볤, ݲ false
+      static bool Measure(const char* data, size_t size, bool host_to_network_byte_order, size_t& wire_size);
+
+      ///<Ϣ볤
+      bool GetWireSize(size_t& wire_size) const
+      {
+          return Resolve(kFieldCount, wire_size);
+      }
+    public:
+      bool GetDeliverQty1(Qty_Def& value) const ///<交付数量
+      {
+          if (size_ < 8) return false;
+          Load<kByteOrder>(data_ + 0, host_to_network_byte_order_, value);
+          return true;
+      }
+      bool GetMyID1(AccountID_Def& value) const ///<ID
+      {
+          if (size_ < 18) return false;
+          Load<kByteOrder>(data_ + 8, host_to_network_byte_order_, value);
+          return true;
+      }
+      bool GetUserInfo1(std::string_view& value) const ///<user
+      {
+          size_t offset = 0;
+          uint32_t length = 0;
+          if (!Resolve(2, offset) || !LoadLength<kByteOrder>(data_ + offset, size_ - offset, host_to_network_byte_order_, length)) return false;
+          if (size_ - offset - 4 < length) return false;
+          value = std::string_view(data_ + offset + 4, length);
+          return true;
+      }
+      bool GetDeliverQty(Qty_Def& value) const ///<交付数量
+      {
+          size_t offset = 0;
+          if (!Resolve(3, offset) || size_ - offset < 8) return false;
+          Load<kByteOrder>(data_ + offset, host_to_network_byte_order_, value);
+          return true;
+      }
+      bool GetMyID(AccountID_Def& value) const ///<ID
+      {
+          size_t offset = 0;
+          if (!Resolve(4, offset) || size_ - offset < 10) return false;
+          Load<kByteOrder>(data_ + offset, host_to_network_byte_order_, value);
+          return true;
+      }
+      bool GetVOrderCount(uint32_t& count) const ///<序列 Ԫظ
+      {
+          size_t offset = 0;
+          return Resolve(5, offset) && LoadLength<kByteOrder>(data_ + offset, size_ - offset, host_to_network_byte_order_, count);
+      }
+      bool GetVOrder(uint32_t index, TestOrderAccessor& value) const; ///<序列  index Ԫ
+      bool GetVAccountIDCount(uint32_t& count) const ///<序列 Ԫظ
+      {
+          size_t offset = 0;
+          return Resolve(6, offset) && LoadLength<kByteOrder>(data_ + offset, size_ - offset, host_to_network_byte_order_, count);
+      }
+      bool GetVAccountID(uint32_t index, AccountID_Def& value) const; ///<序列  index Ԫ
+    private:
+      ///<ֶ index ƫ, index == kFieldCount ʱΪϢ볤
+      bool Resolve(uint32_t index, size_t& offset) const
+      {
+          if (size_ < kFixedPrefixSize) return false;
+          while (resolved_ <= index - kPrefixFieldCount)
+          {
+              size_t begin = offsets_[resolved_ - 1];
+              size_t field_size = 0;
+              if (!FieldWireSize(kPrefixFieldCount + resolved_ - 1, data_ + begin, size_ - begin, host_to_network_byte_order_, field_size)) return false;
+              offsets_[resolved_] = begin + field_size;
+              ++resolved_;
+          }
+          offset = offsets_[index - kPrefixFieldCount];
+          return true;
+      }
+
+      ///<ǰ׺֮ index ֶεı볤,  remaining  false
+      static bool FieldWireSize(uint32_t index, const char* p, size_t remaining, bool host_to_network_byte_order, size_t& field_size);
+
+      mutable size_t offsets_[kFieldCount - kPrefixFieldCount + 1]; ///<ǰ׺ֶ֮εƫƻ
+      mutable uint32_t resolved_ = 1; ///<offsets_ ֪ĸ
+  }; ///< end of class DeriveMessageAccessor
+
+} ///< end of namespace HAO
+} ///< end of namespace CODE
@@ -0,0 +1,120 @@
+
+#include"MessageEncoder.h"
+#include"MessageDecoder.h"
+#include"ArrayUtil.h"
+
+#include"Header.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  ///<Header 0 消息头部
+  void Header::FillDefaultValue()
+  {
+      message_type = 0; ///<消息类型
+      body_length = 0; ///<消息体长度
+  } ///<end Header FillDefaultValue
+
+  void Header::Clear()
+  {
+      message_type = 0; ///<消息类型
+      body_length = 0; ///<消息体长度
+  } ///<end Header Clear
+
+  uint32_t Header::GetMsgSize() 
+  {
+      return kWireSize;
+  }///<end Header GetMsgSize
+
+  ///<Header  HeaderView õıֶν, ֻ STRING (std::string / std::string_view)
+  template<typename Message, typename Decoder>
+  static mp::ErrorCode DecodeHeaderFields(Message& message, Decoder& decoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      {
+          char scratch[8]; ///<ֶ, ֻһγ
+          const char* p = decoder.Fetch(scratch, 8);
+          if (p == nullptr) return mp::ErrorCode::kReadError;
+          decoder.template Load<kByteOrder>(p + 0, message.message_type); ///<消息类型
+          decoder.template Load<kByteOrder>(p + 4, message.body_length); ///<消息体长度
+      }
+      return ec;
+  } ///<end of DecodeHeaderFields
+
+  template<typename Decoder>
+  mp::ErrorCode Header::DecodeImpl(Decoder& decoder)
+  {
+      HeaderWire wire; ///<Ϣ: һγȼ, һο, ֶתֽ
+      const char* p = decoder.Fetch(reinterpret_cast<char*>(&wire), kWireSize);
+      if (p == nullptr) return mp::ErrorCode::kReadError;
+      if (p != reinterpret_cast<const char*>(&wire)) memcpy(&wire, p, kWireSize);
+      message_type = decoder.template FromWire<kByteOrder>(wire.message_type); ///<消息类型
+      body_length = decoder.template FromWire<kByteOrder>(wire.body_length); ///<消息体长度
+      return mp::ErrorCode::kSuccess;
+  } ///<end of Header DecodeImpl
+
+  mp::ErrorCode Header::Decode(mp::MessageDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of Header Decode
+
+  mp::ErrorCode Header::Decode(mp::SegmentedMessageDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of Header Decode
+
+  mp::ErrorCode Header::Decode(mp::MessageViewDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of Header Decode
+
+  mp::ErrorCode HeaderView::Decode(mp::MessageViewDecoder& decoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      ec = DecodeHeaderFields(*this, decoder);
+      return ec;
+  } ///<end of HeaderView Decode
+
+  bool HeaderAccessor::Measure(const char* /*data*/, size_t size, bool /*host_to_network_byte_order*/, size_t& wire_size)
+  {
+      if (size < kFixedPrefixSize) return false;
+      wire_size = kFixedPrefixSize;
+      return true;
+  } ///<end of HeaderAccessor Measure
+   
+  template<typename Encoder>
+  mp::ErrorCode Header::EncodeImpl(Encoder& encoder)
+  {
+      HeaderWire wire; ///<Ϣ: ֶתֽ, һд
+      wire.message_type = encoder.template ToWire<kByteOrder>(message_type); ///<消息类型
+      wire.body_length = encoder.template ToWire<kByteOrder>(body_length); ///<消息体长度
+      return encoder.Write(reinterpret_cast<const char*>(&wire), kWireSize);
+  } ///<end of Header EncodeImpl
+
+  mp::ErrorCode Header::Encode(mp::MessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of Header Encode
+
+  mp::ErrorCode Header::Encode(mp::SegmentedMessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of Header Encode
+
+  mp::ErrorCode Header::Encode(mp::CursorMessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of Header Encode
+   
+  void Header::Dump(std::ostream& ostream) 
+  {
+      ostream << "[Header]" << "[0]:";
+      ostream << "message_type:" << message_type; ///<消息类型
+      ostream << "|"; 
+      ostream << "body_length:" << body_length; ///<消息体长度
+  } ///<end of Header Dump
+
+} ///<end of namespace HAO
+} ///<end of namespace CODE
@@ -0,0 +1,148 @@
+
+#pragma once
+
+#include<cstddef>
+#include<vector>
+#include<string_view>
+#include"TypesDefinition.h"
+#include"MessageTypesDefinition.h"
+#include"MessageAccessor.h"
+
+#include"MessageBase.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  /**
+  * @brief HeaderWire
+  *  Header ֻжֶ(), 뼴˴ṹ, һο
+  */
+#pragma pack(push, 1)
+  struct HeaderWire
+  {
+      uint32_t message_type; ///<消息类型
+      uint32_t body_length; ///<消息体长度
+  };
+#pragma pack(pop)
+  static_assert(sizeof(HeaderWire) == 8, "HeaderWire size");
+  static_assert(offsetof(HeaderWire, message_type) == 0, "HeaderWire message_type offset");
+  static_assert(offsetof(HeaderWire, body_length) == 4, "HeaderWire body_length offset");
+
+  /**
+  * @brief Header
+  *  0 消息头部
+  */
+  class Header final: public mp::MessageBase 
+  {
+    public:
+      static constexpr uint32_t kMinWireSize = 8; ///<̱볤(), STRING/Sequence Ϊ
+      static constexpr uint32_t kFixedPrefixSize = 8; ///<һ STRING/Sequence ֮ǰĶ
+      static constexpr uint32_t kMaxWireSize = 8; ///<볤, ֻжֶʱ
+      static constexpr uint32_t kWireSize = 8; ///<Ϣ볤,  GetMsgSize()
+      Header() = default;
+      Header(const Header&) = default;
+      Header(Header&&) noexcept = default; ///<ƶ, ̼߳䴫
+      Header& operator=(const Header&) = default;
+      Header& operator=(Header&&) noexcept = default;
+      virtual void FillDefaultValue() override;
+      virtual void Clear() override;
+      virtual mp::MsgType_Def GetMsgType() override 
+      { 
+          ///<0 消息头部
+          return 0;
+      }
+      virtual uint32_t GetMsgSize() override;
+      virtual mp::ErrorCode Decode(mp::MessageDecoder& decoder) override;
+      virtual mp::ErrorCode Decode(mp::SegmentedMessageDecoder& decoder) override;
+      virtual mp::ErrorCode Decode(mp::MessageViewDecoder& decoder) override;
+      virtual mp::ErrorCode Encode(mp::MessageEncoder& encoder) override;
+      virtual mp::ErrorCode Encode(mp::SegmentedMessageEncoder& encoder) override;
+      virtual mp::ErrorCode Encode(mp::CursorMessageEncoder& encoder) override;
+      virtual void Dump(std::ostream& ostream) override;
+    protected:
+      template<typename Decoder>
+      mp::ErrorCode DecodeImpl(Decoder& decoder);
+      template<typename Encoder>
+      mp::ErrorCode EncodeImpl(Encoder& encoder);
+    public:
+      uint32_t message_type; ///<消息类型
+      uint32_t body_length; ///<消息体长度
+  }; ///< end of class Header
+
+  /**
+  * @brief HeaderView
+  *  ֻ Header: STRING ֶָѽֽڵ std::string_view,
+  *  ֻ mp::DataBufferView ԴڴڼЧ
+  */
+  class HeaderView
+  {
+    public:
+      mp::ErrorCode Decode(mp::MessageViewDecoder& decoder);
+    public:
+      uint32_t message_type; ///<消息类型
+      uint32_t body_length; ///<消息体长度
+  }; ///< end of class HeaderView
+
+  /**
+  * @brief HeaderAccessor
+  *  ֱֶӶȡѱ Header,  Decode. ֶ,  Accessor þ
+  *  ǰ׺ֶƫǳ; Խ STRING/Sequence ֶεһηʱһ鲢ƫ
+  */
+  class HeaderAccessor : public mp::MessageAccessor
+  {
+    public:
+      static const uint32_t kFieldCount = 2; ///<ֶ()
+      static const uint32_t kPrefixFieldCount = 2; ///<ǰ׺ֶ
+      static const uint32_t kFixedPrefixSize = Header::kFixedPrefixSize; ///<ǰ׺ֽ
+
+      HeaderAccessor(const char* data, size_t size, bool host_to_network_byte_order = true)
+          : mp::MessageAccessor(data, size, host_to_network_byte_order)
+      {
+          offsets_[0] = kFixedPrefixSize;
+      }
+
+      ///< Accessor, ǶϢ Get , ֵǰ Get  false
+      HeaderAccessor()
+          : HeaderAccessor(nullptr, 0)
+      {
+      }
+
+      ///<data һϢı볤, ݲ false
+      static bool Measure(const char* data, size_t size, bool host_to_network_byte_order, size_t& wire_size);
+
+      ///<Ϣ볤
+      bool GetWireSize(size_t& wire_size) const
+      {
+          return Resolve(kFieldCount, wire_size);
+      }
+    public:
+      bool Getmessage_type(uint32_t& value) const ///<消息类型
+      {
+          if (size_ < 4) return false;
+          Load<kByteOrder>(data_ + 0, host_to_network_byte_order_, value);
+          return true;
+      }
+      bool Getbody_length(uint32_t& value) const ///<消息体长度
+      {
+          if (size_ < 8) return false;
+          Load<kByteOrder>(data_ + 4, host_to_network_byte_order_, value);
+          return true;
+      }
+    private:
+      ///<ֶ index ƫ, index == kFieldCount ʱΪϢ볤
+      bool Resolve(uint32_t index, size_t& offset) const
+      {
+          if (size_ < kFixedPrefixSize) return false;
+          offset = offsets_[index - kPrefixFieldCount];
+          return true;
+      }
+
+
+      mutable size_t offsets_[kFieldCount - kPrefixFieldCount + 1]; ///<ǰ׺ֶ֮εƫƻ
+      mutable uint32_t resolved_ = 1; ///<offsets_ ֪ĸ
+  }; ///< end of class HeaderAccessor
+
+} ///< end of namespace HAO
+} ///< end of namespace CODE
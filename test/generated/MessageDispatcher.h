@@ -0,0 +1,161 @@
+#pragma once
+
+#include<tuple>
+#include<type_traits>
+#include<utility>
+#include"BatchDecoder.h"
+#include"BatchEncoder.h"
+#include"FrameHeader.h"
+#include"MessageDecoder.h"
+#include"MessageEncoder.h"
+#include"MessageFramer.h"
+#include"MessageTypesDefinition.h"
+
+#include"BaseMessage.h"
+#include"DeriveMessage.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  ///<frames a byte stream in the schema byte order, feed its frames to Dispatch(frame.data, frame.Size());
+  ///<headers with an unknown message number or a body_length outside kWireSizeLimits are rejected
+  ///<before the body is buffered
+  class message_definitionMessageFramer : public mp::MessageFramer<kByteOrder>
+  {
+    public:
+      explicit message_definitionMessageFramer(mp::DataBuffer& buffer, bool host_to_network_byte_order = true,
+          uint32_t max_body_length = mp::kDefaultMaxBodyLength) noexcept
+          : mp::MessageFramer<kByteOrder>(buffer, host_to_network_byte_order, max_body_length, &FindWireSizeLimits)
+      {
+      }
+  };
+
+  ///<appends message to buffer as one frame, header in the schema byte order (see mp::EncodeFrame)
+  inline mp::ErrorCode message_definitionEncodeFrame(mp::MessageBase& message, mp::DataBuffer& buffer, uint32_t msg_size, bool host_to_network_byte_order = true)
+  {
+      return mp::EncodeFrame<kByteOrder>(message, buffer, msg_size, host_to_network_byte_order);
+  }
+
+  inline mp::ErrorCode message_definitionEncodeFrame(mp::MessageBase& message, mp::DataBuffer& buffer, bool host_to_network_byte_order = true)
+  {
+      return mp::EncodeFrame<kByteOrder>(message, buffer, host_to_network_byte_order);
+  }
+
+  ///<batches frames with headers in the schema byte order, read back by message_definitionMessageFramer
+  using message_definitionBatchEncoder = mp::BatchEncoder<kByteOrder>;
+
+  ///<decodes all the frames of a read in one call, each into a reused instance of the type its
+  ///<message number names, with an error code per frame (see mp::BatchDecoder)
+  using message_definitionBatchDecoder = mp::BatchDecoder<kByteOrder, BaseMessage, DeriveMessage>;
+
+  /**
+  * @brief message_definitionMessageDispatcher
+  *  decodes a frame (mp::FrameHeader + body) into the reused instance of its concrete type and
+  *  calls handler.On(const X&) directly: no heap object, no virtual call, no cast.
+  *  Types the handler has no On() overload for are skipped without decoding; an On(const Base&)
+  *  overload also receives the messages derived from Base.
+  *  The instances are reused across calls, so use one dispatcher per thread.
+  */
+  template<typename Handler>
+  class message_definitionMessageDispatcher
+  {
+    public:
+      explicit message_definitionMessageDispatcher(Handler& handler, bool host_to_network_byte_order = true)
+          : handler_(handler)
+          , host_to_network_byte_order_(host_to_network_byte_order)
+      {
+      }
+
+      ///<whole frame in [data, data + size); kReadError if truncated, unknown, not decodable or
+      ///<with bytes left over after the message
+      mp::ErrorCode Dispatch(const char* data, size_t size)
+      {
+          if (size < mp::FrameHeader::kSize)
+          {
+              return mp::ErrorCode::kReadError;
+          }
+
+          mp::FrameHeader header = mp::FrameHeader::Load<kByteOrder>(data, host_to_network_byte_order_);
+          if (size - mp::FrameHeader::kSize < header.body_length)
+          {
+              return mp::ErrorCode::kReadError;
+          }
+
+          return Dispatch(header.message_type, data + mp::FrameHeader::kSize, header.body_length);
+      }
+
+      ///<body of a msg_type message, without its frame header
+      mp::ErrorCode Dispatch(mp::MsgType_Def msg_type, const char* body, size_t body_length)
+      {
+          switch (msg_type)
+          {
+          case kBaseMessage: return DispatchAs<BaseMessage>(body, body_length); //<基础类
+          case kDeriveMessage: return DispatchAs<DeriveMessage>(body, body_length); //<子类
+          default: return mp::ErrorCode::kReadError;
+          }
+      }
+
+      ///<whether Handler has an On() overload accepting const T&
+      template<typename T>
+      static constexpr bool Handles() noexcept
+      {
+          return HasOn<T>(0);
+      }
+
+      ///<the reused T, holds the last dispatched T
+      template<typename T>
+      T& Instance() noexcept
+      {
+          return std::get<T>(messages_);
+      }
+
+    private:
+      template<typename T, typename H = Handler>
+      static constexpr auto HasOn(int) -> decltype(std::declval<H&>().On(std::declval<const T&>()), true)
+      {
+          return true;
+      }
+
+      template<typename T>
+      static constexpr bool HasOn(...)
+      {
+          return false;
+      }
+
+      template<typename T>
+      mp::ErrorCode DispatchAs(const char* body, size_t body_length)
+      {
+          if constexpr (HasOn<T>(0))
+          {
+              mp::DataBufferView view(body, body_length);
+              mp::MessageViewDecoder decoder(view, host_to_network_byte_order_);
+              T& message = std::get<T>(messages_);
+              mp::ErrorCode ec = message.T::Decode(decoder); ///<qualified call, no virtual dispatch
+              if (ec != mp::ErrorCode::kSuccess)
+              {
+                  return ec;
+              }
+
+              if (view.Size() != 0)
+              {
+                  return mp::ErrorCode::kReadError; ///<body_length longer than the message
+              }
+
+              handler_.On(static_cast<const T&>(message));
+              return ec;
+          }
+          else
+          {
+              return mp::ErrorCode::kSuccess;
+          }
+      }
+
+      Handler& handler_;
+      bool host_to_network_byte_order_;
+      std::tuple<BaseMessage, DeriveMessage> messages_;
+  }; ///< end of class message_definitionMessageDispatcher
+
+} //end of namespace HAO
+} //end of namespace CODE
@@ -0,0 +1,61 @@
+
+#pragma once
+
+#include"AutoFactory.h"
+//#include"MpCustomKey.h"
+#include"MessageBase.h"
+#include"MpTypes.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+//struct message_definition{};
+//using message_definitionMessageFactory = mp::factory<MpCustomKey<message_definition>, mp::MessageBase>;
+
+///<ʱע: ֻ REGIST_ עԶϢ, get().create() ɵϢ nullptr,  CREATE_/ACQUIRE_ 
+using message_definitionMessageFactory = mp::factory<mp::MsgType_Def , mp::MessageBase>;
+
+///<ʱȷϢ: Create/Acquire Ϣ switch ַ, ʱûо̬ע
+struct message_definitionMessageTable
+{
+    ///<Ϣ
+    static constexpr mp::MsgType_Def kMsgTypes[] = { 1001, 1002 };
+    static constexpr size_t kMsgCount = sizeof(kMsgTypes) / sizeof(kMsgTypes[0]);
+
+    ///<ֲϢű
+    static constexpr bool Contains(mp::MsgType_Def msg_no) noexcept
+    {
+        size_t low = 0;
+        size_t high = kMsgCount;
+        while (low < high)
+        {
+            size_t mid = low + (high - low) / 2;
+            if (kMsgTypes[mid] < msg_no)
+                low = mid + 1;
+            else
+                high = mid;
+        }
+        return low < kMsgCount && kMsgTypes[low] == msg_no;
+    }
+
+    ///<ɵϢϢ switch , ϢŽ message_definitionMessageFactory (REGIST_ עԶϢ), ûз nullptr
+    static mp::MessageBase* Create(mp::MsgType_Def msg_no);
+    ///<ͬ, ӶȡϢ, ûзؿָ
+    static message_definitionMessageFactory::pooled_ptr Acquire(mp::MsgType_Def msg_no);
+};
+
+
+
+} ///<end of namespace HAO
+} ///<end of namespace CODE
+
+///<ʱעԶϢ message_definitionMessageFactory, ֮ CREATE_/ACQUIRE_  get().create(msg_no) ɴ;
+///<ɵϢ, get().create() Ƿ nullptr
+#define REGIST_MESSAGE_DEFINITION_MESSAGE(msg_no,MESSAGE) HAO::CODE::message_definitionMessageFactory::register_t<MESSAGE> s_##MESSAGE##msg_no(msg_no)
+
+///<Ϣ
+#define CREATE_MESSAGE_DEFINITION_MESSAGE(msg_no) HAO::CODE::message_definitionMessageTable::Create(msg_no);
+///<ӶȡϢ, ص pooled_ptr ʱ Clear() Żس
+#define ACQUIRE_MESSAGE_DEFINITION_MESSAGE(msg_no) HAO::CODE::message_definitionMessageTable::Acquire(msg_no);
@@ -0,0 +1,34 @@
+#pragma once
+
+#include"MessageFactory.h"
+
+#include"BaseMessage.h"
+#include"DeriveMessage.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+mp::MessageBase* message_definitionMessageTable::Create(mp::MsgType_Def msg_no)
+{
+    switch (msg_no)
+    {
+    case 1001: return new BaseMessage(); //<基础类
+    case 1002: return new DeriveMessage(); //<子类
+    default: return message_definitionMessageFactory::get().create(msg_no); //<custom messages added with REGIST_
+    }
+}
+
+message_definitionMessageFactory::pooled_ptr message_definitionMessageTable::Acquire(mp::MsgType_Def msg_no)
+{
+    switch (msg_no)
+    {
+    case 1001: return message_definitionMessageFactory::acquire_pooled<BaseMessage>(); //<基础类
+    case 1002: return message_definitionMessageFactory::acquire_pooled<DeriveMessage>(); //<子类
+    default: return message_definitionMessageFactory::get().acquire(msg_no); //<custom messages added with REGIST_
+    }
+}
+
+} //end of namespace HAO
+} //end of namespace CODE
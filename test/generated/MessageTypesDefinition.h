@@ -0,0 +1,40 @@
+
+#pragma once
+
+#include<vector>
+#include"MpTypes.h"
+#include"DataBuffer.hpp"
+
+namespace HAO
+{
+namespace CODE
+{
+
+    ///<byte order of integer fields, from the schema Endian attribute;
+    ///<kRuntime (Endian native) leaves it to the encoder/decoder host_to_network_byte_order flag
+    static const mp::DataBuffer::ByteOrder kByteOrder = mp::DataBuffer::ByteOrder::kRuntime;
+
+    static const mp::MsgType_Def kBaseMessage = 1001 ; //<基础类
+    static const mp::MsgType_Def kDeriveMessage = 1002 ; //<子类
+
+    ///<encoded size limits per message number (inheritance included); same values as the
+    ///<kMinWireSize/kFixedPrefixSize/kMaxWireSize members of each message
+    static constexpr mp::WireSizeLimits kWireSizeLimits[] =
+    {
+        { 1001, 22, 18, mp::kUnboundedWireSize}, //<BaseMessage
+        { 1002, 48, 18, mp::kUnboundedWireSize}, //<DeriveMessage
+    };
+
+    ///<size limits of message msg_type, nullptr for an unknown message number
+    inline const mp::WireSizeLimits* FindWireSizeLimits(mp::MsgType_Def msg_type)
+    {
+        switch (msg_type)
+        {
+        case 1001: return &kWireSizeLimits[0];
+        case 1002: return &kWireSizeLimits[1];
+        default: return nullptr;
+        }
+    }
+
+} //end of namespace HAO
+} //end of namespace CODE
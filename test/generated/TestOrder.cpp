@@ -0,0 +1,134 @@
+
+#include"MessageEncoder.h"
+#include"MessageDecoder.h"
+#include"ArrayUtil.h"
+
+#include"TestOrder.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  ///<TestOrder 0 基础类
+  void TestOrder::FillDefaultValue()
+  {
+      DeliverQty = 0; ///<交付数量
+      MyID.fill(' '); ///<ID
+      OrderID = 0; ///<ID
+      FundAccoutId.fill(' '); ///<fund account ID
+  } ///<end TestOrder FillDefaultValue
+
+  void TestOrder::Clear()
+  {
+      DeliverQty = 0; ///<交付数量
+      MyID.fill(' '); ///<ID
+      OrderID = 0; ///<ID
+      FundAccoutId.fill(' '); ///<fund account ID
+  } ///<end TestOrder Clear
+
+  uint32_t TestOrder::GetMsgSize() 
+  {
+      return kWireSize;
+  }///<end TestOrder GetMsgSize
+
+  ///<TestOrder  TestOrderView õıֶν, ֻ STRING (std::string / std::string_view)
+  template<typename Message, typename Decoder>
+  static mp::ErrorCode DecodeTestOrderFields(Message& message, Decoder& decoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      {
+          char scratch[36]; ///<ֶ, ֻһγ
+          const char* p = decoder.Fetch(scratch, 36);
+          if (p == nullptr) return mp::ErrorCode::kReadError;
+          decoder.template Load<kByteOrder>(p + 0, message.DeliverQty); ///<交付数量
+          decoder.template Load<kByteOrder>(p + 8, message.MyID); ///<ID
+          decoder.template Load<kByteOrder>(p + 18, message.OrderID); ///<ID
+          decoder.template Load<kByteOrder>(p + 26, message.FundAccoutId); ///<fund account ID
+      }
+      return ec;
+  } ///<end of DecodeTestOrderFields
+
+  template<typename Decoder>
+  mp::ErrorCode TestOrder::DecodeImpl(Decoder& decoder)
+  {
+      TestOrderWire wire; ///<Ϣ: һγȼ, һο, ֶתֽ
+      const char* p = decoder.Fetch(reinterpret_cast<char*>(&wire), kWireSize);
+      if (p == nullptr) return mp::ErrorCode::kReadError;
+      if (p != reinterpret_cast<const char*>(&wire)) memcpy(&wire, p, kWireSize);
+      DeliverQty = decoder.template FromWire<kByteOrder>(wire.DeliverQty); ///<交付数量
+      MyID = decoder.template FromWire<kByteOrder>(wire.MyID); ///<ID
+      OrderID = decoder.template FromWire<kByteOrder>(wire.OrderID); ///<ID
+      FundAccoutId = decoder.template FromWire<kByteOrder>(wire.FundAccoutId); ///<fund account ID
+      return mp::ErrorCode::kSuccess;
+  } ///<end of TestOrder DecodeImpl
+
+  mp::ErrorCode TestOrder::Decode(mp::MessageDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of TestOrder Decode
+
+  mp::ErrorCode TestOrder::Decode(mp::SegmentedMessageDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of TestOrder Decode
+
+  mp::ErrorCode TestOrder::Decode(mp::MessageViewDecoder& decoder)
+  {
+      return DecodeImpl(decoder);
+  } ///<end of TestOrder Decode
+
+  mp::ErrorCode TestOrderView::Decode(mp::MessageViewDecoder& decoder)
+  {
+      mp::ErrorCode ec=mp::ErrorCode::kSuccess;
+      ec = DecodeTestOrderFields(*this, decoder);
+      return ec;
+  } ///<end of TestOrderView Decode
+
+  bool TestOrderAccessor::Measure(const char* /*data*/, size_t size, bool /*host_to_network_byte_order*/, size_t& wire_size)
+  {
+      if (size < kFixedPrefixSize) return false;
+      wire_size = kFixedPrefixSize;
+      return true;
+  } ///<end of TestOrderAccessor Measure
+   
+  template<typename Encoder>
+  mp::ErrorCode TestOrder::EncodeImpl(Encoder& encoder)
+  {
+      TestOrderWire wire; ///<Ϣ: ֶתֽ, һд
+      wire.DeliverQty = encoder.template ToWire<kByteOrder>(DeliverQty); ///<交付数量
+      wire.MyID = encoder.template ToWire<kByteOrder>(MyID); ///<ID
+      wire.OrderID = encoder.template ToWire<kByteOrder>(OrderID); ///<ID
+      wire.FundAccoutId = encoder.template ToWire<kByteOrder>(FundAccoutId); ///<fund account ID
+      return encoder.Write(reinterpret_cast<const char*>(&wire), kWireSize);
+  } ///<end of TestOrder EncodeImpl
+
+  mp::ErrorCode TestOrder::Encode(mp::MessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of TestOrder Encode
+
+  mp::ErrorCode TestOrder::Encode(mp::SegmentedMessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of TestOrder Encode
+
+  mp::ErrorCode TestOrder::Encode(mp::CursorMessageEncoder& encoder)
+  {
+      return EncodeImpl(encoder);
+  } ///<end of TestOrder Encode
+   
+  void TestOrder::Dump(std::ostream& ostream) 
+  {
+      ostream << "[TestOrder]" << "[0]:";
+      ostream << "DeliverQty:" << DeliverQty; ///<交付数量
+      ostream << "|"; 
+      ostream << "MyID:" <<mp::ToStringTrim(MyID); ///<ID
+      ostream << "|"; 
+      ostream << "OrderID:" << OrderID; ///<ID
+      ostream << "|"; 
+      ostream << "FundAccoutId:" <<mp::ToStringTrim(FundAccoutId); ///<fund account ID
+  } ///<end of TestOrder Dump
+
+} ///<end of namespace HAO
+} ///<end of namespace CODE
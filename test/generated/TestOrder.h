@@ -0,0 +1,168 @@
+
+#pragma once
+
+#include<cstddef>
+#include<vector>
+#include<string_view>
+#include"TypesDefinition.h"
+#include"MessageTypesDefinition.h"
+#include"MessageAccessor.h"
+
+#include"MessageBase.h"
+
+namespace HAO
+{
+namespace CODE
+{
+
+  /**
+  * @brief TestOrderWire
+  *  TestOrder ֻжֶ(), 뼴˴ṹ, һο
+  */
+#pragma pack(push, 1)
+  struct TestOrderWire
+  {
+      Qty_Def DeliverQty; ///<交付数量
+      AccountID_Def MyID; ///<ID
+      uint64_t OrderID; ///<ID
+      std::array<char,10> FundAccoutId; ///<fund account ID
+  };
+#pragma pack(pop)
+  static_assert(sizeof(TestOrderWire) == 36, "TestOrderWire size");
+  static_assert(offsetof(TestOrderWire, DeliverQty) == 0, "TestOrderWire DeliverQty offset");
+  static_assert(offsetof(TestOrderWire, MyID) == 8, "TestOrderWire MyID offset");
+  static_assert(offsetof(TestOrderWire, OrderID) == 18, "TestOrderWire OrderID offset");
+  static_assert(offsetof(TestOrderWire, FundAccoutId) == 26, "TestOrderWire FundAccoutId offset");
+
+  /**
+  * @brief TestOrder
+  *  0 基础类
+  */
+  class TestOrder final: public mp::MessageBase 
+  {
+    public:
+      static constexpr uint32_t kMinWireSize = 36; ///<̱볤(), STRING/Sequence Ϊ
+      static constexpr uint32_t kFixedPrefixSize = 36; ///<һ STRING/Sequence ֮ǰĶ
+      static constexpr uint32_t kMaxWireSize = 36; ///<볤, ֻжֶʱ
+      static constexpr uint32_t kWireSize = 36; ///<Ϣ볤,  GetMsgSize()
+      TestOrder() = default;
+      TestOrder(const TestOrder&) = default;
+      TestOrder(TestOrder&&) noexcept = default; ///<ƶ, ̼߳䴫
+      TestOrder& operator=(const TestOrder&) = default;
+      TestOrder& operator=(TestOrder&&) noexcept = default;
+      virtual void FillDefaultValue() override;
+      virtual void Clear() override;
+      virtual mp::MsgType_Def GetMsgType() override 
+      { 
+          ///<0 基础类
+          return 0;
+      }
+      virtual uint32_t GetMsgSize() override;
+      virtual mp::ErrorCode Decode(mp::MessageDecoder& decoder) override;
+      virtual mp::ErrorCode Decode(mp::SegmentedMessageDecoder& decoder) override;
+      virtual mp::ErrorCode Decode(mp::MessageViewDecoder& decoder) override;
+      virtual mp::ErrorCode Encode(mp::MessageEncoder& encoder) override;
+      virtual mp::ErrorCode Encode(mp::SegmentedMessageEncoder& encoder) override;
+      virtual mp::ErrorCode Encode(mp::CursorMessageEncoder& encoder) override;
+      virtual void Dump(std::ostream& ostream) override;
+    protected:
+      template<typename Decoder>
+      mp::ErrorCode DecodeImpl(Decoder& decoder);
+      template<typename Encoder>
+      mp::ErrorCode EncodeImpl(Encoder& encoder);
+    public:
+      Qty_Def DeliverQty; ///<交付数量
+      AccountID_Def MyID; ///<ID
+      uint64_t OrderID; ///<ID
+      std::array<char,10> FundAccoutId; ///<fund account ID
+  }; ///< end of class TestOrder
+
+  /**
+  * @brief TestOrderView
+  *  ֻ TestOrder: STRING ֶָѽֽڵ std::string_view,
+  *  ֻ mp::DataBufferView ԴڴڼЧ
+  */
+  class TestOrderView
+  {
+    public:
+      mp::ErrorCode Decode(mp::MessageViewDecoder& decoder);
+    public:
+      Qty_Def DeliverQty; ///<交付数量
+      AccountID_Def MyID; ///<ID
+      uint64_t OrderID; ///<ID
+      std::array<char,10> FundAccoutId; ///<fund account ID
+  }; ///< end of class TestOrderView
+
+  /**
+  * @brief TestOrderAccessor
+  *  ֱֶӶȡѱ TestOrder,  Decode. ֶ,  Accessor þ
+  *  ǰ׺ֶƫǳ; Խ STRING/Sequence ֶεһηʱһ鲢ƫ
+  */
+  class TestOrderAccessor : public mp::MessageAccessor
+  {
+    public:
+      static const uint32_t kFieldCount = 4; ///<ֶ()
+      static const uint32_t kPrefixFieldCount = 4; ///<ǰ׺ֶ
+      static const uint32_t kFixedPrefixSize = TestOrder::kFixedPrefixSize; ///<ǰ׺ֽ
+
+      TestOrderAccessor(const char* data, size_t size, bool host_to_network_byte_order = true)
+          : mp::MessageAccessor(data, size, host_to_network_byte_order)
+      {
+          offsets_[0] = kFixedPrefixSize;
+      }
+
+      ///< Accessor, ǶϢ Get , ֵǰ Get  false
+      TestOrderAccessor()
+          : TestOrderAccessor(nullptr, 0)
+      {
+      }
+
+      ///<data һϢı볤, ݲ false
+      static bool Measure(const char* data, size_t size, bool host_to_network_byte_order, size_t& wire_size);
+
+      ///<Ϣ볤
+      bool GetWireSize(size_t& wire_size) const
+      {
+          return Resolve(kFieldCount, wire_size);
+      }
+    public:
+      bool GetDeliverQty(Qty_Def& value) const ///<交付数量
+      {
+          if (size_ < 8) return false;
+          Load<kByteOrder>(data_ + 0, host_to_network_byte_order_, value);
+          return true;
+      }
+      bool GetMyID(AccountID_Def& value) const ///<ID
+      {
+          if (size_ < 18) return false;
+          Load<kByteOrder>(data_ + 8, host_to_network_byte_order_, value);
+          return true;
+      }
+      bool GetOrderID(uint64_t& value) const ///<ID
+      {
+          if (size_ < 26) return false;
+          Load<kByteOrder>(data_ + 18, host_to_network_byte_order_, value);
+          return true;
+      }
+      bool GetFundAccoutId(std::array<char,10>& value) const ///<fund account ID
+      {
+          if (size_ < 36) return false;
+          Load<kByteOrder>(data_ + 26, host_to_network_byte_order_, value);
+          return true;
+      }
+    private:
+      ///<ֶ index ƫ, index == kFieldCount ʱΪϢ볤
+      bool Resolve(uint32_t index, size_t& offset) const
+      {
+          if (size_ < kFixedPrefixSize) return false;
+          offset = offsets_[index - kPrefixFieldCount];
+          return true;
+      }
+
+
+      mutable size_t offsets_[kFieldCount - kPrefixFieldCount + 1]; ///<ǰ׺ֶ֮εƫƻ
+      mutable uint32_t resolved_ = 1; ///<offsets_ ֪ĸ
+  }; ///< end of class TestOrderAccessor
+
+} ///< end of namespace HAO
+} ///< end of namespace CODE
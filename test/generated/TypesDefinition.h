@@ -0,0 +1,31 @@
+
+#pragma once
+
+#include<string>
+#include<array>
+#include<stdint.h>
+
+namespace HAO
+{
+namespace CODE
+{
+
+    using CHAR = char;   ///<CHAR
+    using UCHAR = unsigned char;   ///<UNSIGNED CHAR
+    using BOOL = bool;   ///<BOOL
+    using INT8 = int8_t;   ///<INT8_T
+    using UINT8 = uint8_t;   ///<UINT8_T
+    using INT16 = int16_t;   ///<INT8_T
+    using UINT16 = uint16_t;   ///<UINT16_T
+    using INT32 = int32_t;   ///<INT32_T
+    using UINT32 = uint32_t;   ///<UINT32_T
+    using INT64 = int64_t;   ///<INT64_T
+    using UINT64 = uint64_t;   ///<UINT64_T
+    using STRING = std::string;   ///<STD::STRING
+    using Currency_Def = std::array<char,5>;   ///<币种
+    using UserInfo_Def = std::string;   ///<用户信息
+    using AccountID_Def = std::array<char,10>;   ///<账户id
+    using Qty_Def = int64_t;   ///<最低成交数量
+
+} ///<end of namespace HAO
+} ///<end of namespace CODE